@@ -9,6 +9,7 @@ public class GAS_Aura_DemoTarget : TargetRules
 	{
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
+		bWithPushModel = true;
 
 		ExtraModuleNames.AddRange( new string[] { "GAS_Aura_Demo" } );
 	}
@@ -12,7 +12,7 @@ public class GAS_Aura_Demo : ModuleRules
 			{ "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "GameplayAbilities" });
 
 		PrivateDependencyModuleNames.AddRange(new string[]
-			{ "GameplayTags", "GameplayTasks", "NavigationSystem", "Niagara" ,"AIModule"});
+			{ "GameplayTags", "GameplayTasks", "NavigationSystem", "Niagara" ,"AIModule", "SignificanceManager", "ReplicationGraph", "NetCore", "OnlineSubsystemUtils", "Json"});
 
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
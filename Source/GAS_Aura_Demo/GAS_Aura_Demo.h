@@ -6,3 +6,4 @@
 
 #define CUSTOM_DEPTH_RED 250
 #define ECC_Projectile ECollisionChannel::ECC_GameTraceChannel1
+#define ECC_EnemyProjectile ECollisionChannel::ECC_GameTraceChannel2
@@ -3,13 +3,45 @@
 
 #include "AI/AuraAIController.h"
 
-#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "AuraStats.h"
+#include "AI/AuraAILODSubsystem.h"
+#include "AI/AuraBehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 
 AAuraAIController::AAuraAIController()
 {
+	LLM_SCOPE_BYTAG(Aura_AI);
 	Blackboard=CreateDefaultSubobject<UBlackboardComponent>("BlackboardComponent");
 	check(Blackboard);
-	BehaviorTreeComponent=CreateDefaultSubobject<UBehaviorTreeComponent>("BehaviorTreeComponent");
+	BehaviorTreeComponent=CreateDefaultSubobject<UAuraBehaviorTreeComponent>("BehaviorTreeComponent");
 	check(BehaviorTreeComponent);
+	//RunBehaviorTree 只会复用 BrainComponent，否则会另建一个普通的行为树组件
+	BrainComponent=BehaviorTreeComponent;
+}
+
+void AAuraAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+	if (UAuraAILODSubsystem* AILODSubsystem = UAuraAILODSubsystem::Get(this))
+	{
+		AILODSubsystem->RegisterController(this);
+	}
+}
+
+void AAuraAIController::OnUnPossess()
+{
+	if (UAuraAILODSubsystem* AILODSubsystem = UAuraAILODSubsystem::Get(this))
+	{
+		AILODSubsystem->UnregisterController(this);
+	}
+	Super::OnUnPossess();
+}
+
+void AAuraAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAuraAILODSubsystem* AILODSubsystem = UAuraAILODSubsystem::Get(this))
+	{
+		AILODSubsystem->UnregisterController(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
@@ -0,0 +1,191 @@
+// Copyright Liupingan
+
+
+#include "AI/AuraAILODSubsystem.h"
+
+#include "AuraStats.h"
+#include "AI/AuraAIController.h"
+#include "AI/AuraBehaviorTreeComponent.h"
+#include "Character/AuraEnemy.h"
+#include "Game/AuraCombatantSubsystem.h"
+#include "Interaction/EnemyInterface.h"
+
+UAuraAILODSubsystem::UAuraAILODSubsystem()
+{
+	LODLevels = {
+		{1500.f, 0.f},
+		{3000.f, 0.1f},
+		{6000.f, 0.25f},
+		{TNumericLimits<float>::Max(), 0.5f},
+	};
+}
+
+UAuraAILODSubsystem* UAuraAILODSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UAuraAILODSubsystem>() : nullptr;
+}
+
+bool UAuraAILODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAuraAILODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraAILODSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraAILODSubsystem::RegisterController(AAuraAIController* Controller)
+{
+	LLM_SCOPE_BYTAG(Aura_Subsystems);
+	if (!IsValid(Controller)) return;
+	if (Controllers.ContainsByPredicate([Controller](const FControllerEntry& Entry) { return Entry.Controller == Controller; })) return;
+
+	FControllerEntry& Entry = Controllers.AddDefaulted_GetRef();
+	Entry.Controller = Controller;
+}
+
+void UAuraAILODSubsystem::UnregisterController(AAuraAIController* Controller)
+{
+	const int32 Index = Controllers.IndexOfByPredicate([Controller](const FControllerEntry& Entry) { return Entry.Controller == Controller; });
+	if (Index == INDEX_NONE) return;
+
+	RemoveControllerAt(Index);
+}
+
+bool UAuraAILODSubsystem::ShouldDeferBehaviorTreeTick(const AAuraAIController* Controller, float DeferredSeconds)
+{
+	ResetFrameAITimeIfNewFrame();
+	if (FrameAITimeSeconds * 1000.0 < AIFrameBudgetMs || DeferredSeconds >= MaxBehaviorTreeDeferSeconds) return false;
+
+	return Controller == nullptr || !IsEngaged(Controller->GetPawn());
+}
+
+void UAuraAILODSubsystem::AddFrameAITime(double Seconds)
+{
+	ResetFrameAITimeIfNewFrame();
+	FrameAITimeSeconds += Seconds;
+}
+
+void UAuraAILODSubsystem::ResetFrameAITimeIfNewFrame()
+{
+	if (FrameAITimeFrame != GFrameCounter)
+	{
+		FrameAITimeFrame = GFrameCounter;
+		FrameAITimeSeconds = 0.0;
+	}
+}
+
+bool UAuraAILODSubsystem::IsEngaged(const APawn* Pawn)
+{
+	const AAuraEnemy* Enemy = Cast<AAuraEnemy>(Pawn);
+	return Enemy && (Enemy->bHitReacting || IEnemyInterface::Execute_GetCombatTarget(Enemy) != nullptr);
+}
+
+void UAuraAILODSubsystem::RemoveControllerAt(int32 Index)
+{
+	if (Controllers[Index].LODLevel == 0)
+	{
+		--NumFullRateControllers;
+	}
+
+	//游标之前是本轮已评估的：先把被删项换到游标前一位，末尾未评估的项才会换到游标处而不被跳过
+	if (Index < EvaluationCursor)
+	{
+		--EvaluationCursor;
+		Controllers.Swap(Index, EvaluationCursor);
+		Index = EvaluationCursor;
+	}
+	Controllers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UAuraAILODSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	if (Controllers.Num() == 0 || LODLevels.Num() == 0) return;
+
+	AURA_COMBAT_SCOPE(STAT_AuraAILODEvaluate, AuraAI);
+
+	TArray<FVector> PlayerLocations;
+	if (const UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(this))
+	{
+		CombatantSubsystem->GetLiveCombatantLocations(EAuraTeam::Player, PlayerLocations);
+	}
+
+	//时间切片：从上次的位置继续，预算用完就留到下一帧
+	const double EvaluationStartTime = FPlatformTime::Seconds();
+	const double BudgetEndTime = EvaluationStartTime + LODEvaluationBudgetMs / 1000.0;
+	for (int32 NumRemaining = Controllers.Num(); NumRemaining > 0 && Controllers.Num() > 0; --NumRemaining)
+	{
+		if (EvaluationCursor >= Controllers.Num())
+		{
+			EvaluationCursor = 0;
+		}
+
+		FControllerEntry& Entry = Controllers[EvaluationCursor];
+		const AAuraAIController* Controller = Entry.Controller.Get();
+		if (Controller == nullptr)
+		{
+			//换到游标处的项下一轮循环重新检查
+			RemoveControllerAt(EvaluationCursor);
+			continue;
+		}
+
+		ApplyLODLevel(Entry, EvaluateLODLevel(Controller, PlayerLocations));
+		++EvaluationCursor;
+
+		if (FPlatformTime::Seconds() >= BudgetEndTime) break;
+	}
+	AddFrameAITime(FPlatformTime::Seconds() - EvaluationStartTime);
+}
+
+int32 UAuraAILODSubsystem::EvaluateLODLevel(const AAuraAIController* Controller, TConstArrayView<FVector> PlayerLocations) const
+{
+	const APawn* Pawn = Controller->GetPawn();
+	if (Pawn == nullptr || PlayerLocations.Num() == 0) return LODLevels.Num() - 1;
+
+	float NearestDistSquared = TNumericLimits<float>::Max();
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		NearestDistSquared = FMath::Min(NearestDistSquared, static_cast<float>(FVector::DistSquared(PlayerLocation, Pawn->GetActorLocation())));
+	}
+
+	//交战中的敌人保持满频
+	if (NearestDistSquared <= FMath::Square(EngagedMaxDistance) && IsEngaged(Pawn))
+	{
+		return 0;
+	}
+
+	for (int32 Level = 0; Level < LODLevels.Num(); ++Level)
+	{
+		if (NearestDistSquared <= FMath::Square(LODLevels[Level].MaxDistance))
+		{
+			return Level;
+		}
+	}
+	return LODLevels.Num() - 1;
+}
+
+void UAuraAILODSubsystem::ApplyLODLevel(FControllerEntry& Entry, int32 NewLODLevel)
+{
+	//满频名额已满时降一级
+	if (NewLODLevel == 0 && Entry.LODLevel != 0 && NumFullRateControllers >= MaxFullRateControllers)
+	{
+		NewLODLevel = FMath::Min(1, LODLevels.Num() - 1);
+	}
+	if (NewLODLevel == Entry.LODLevel) return;
+
+	if (Entry.LODLevel == 0) --NumFullRateControllers;
+	if (NewLODLevel == 0) ++NumFullRateControllers;
+	Entry.LODLevel = NewLODLevel;
+
+	AAuraAIController* Controller = Entry.Controller.Get();
+	const float TickInterval = LODLevels[NewLODLevel].TickInterval;
+	Controller->SetActorTickInterval(TickInterval);
+	//行为树每次 Tick 后都会自己重设间隔，LOD 只能在组件内部作为下限生效
+	if (UAuraBehaviorTreeComponent* BehaviorTreeComponent = Cast<UAuraBehaviorTreeComponent>(Controller->GetBrainComponent()))
+	{
+		BehaviorTreeComponent->SetLODTickInterval(TickInterval);
+	}
+}
@@ -0,0 +1,57 @@
+// Copyright Liupingan
+
+
+#include "AI/AuraBehaviorTreeComponent.h"
+
+#include "AuraStats.h"
+#include "AI/AuraAIController.h"
+#include "AI/AuraAILODSubsystem.h"
+
+void UAuraBehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+                                               FActorComponentTickFunction* ThisTickFunction)
+{
+	UAuraAILODSubsystem* AILODSubsystem = UAuraAILODSubsystem::Get(this);
+	if (AILODSubsystem && AILODSubsystem->ShouldDeferBehaviorTreeTick(Cast<AAuraAIController>(GetOwner()), DeferredDeltaTime))
+	{
+		DeferredDeltaTime += DeltaTime;
+		return;
+	}
+
+	AURA_COMBAT_SCOPE(STAT_AuraBehaviorTreeTick, AuraAI);
+	const double StartTime = FPlatformTime::Seconds();
+	//等待类任务按 DeltaTime 倒计时，被推迟的时间一并补上
+	Super::TickComponent(DeltaTime + DeferredDeltaTime, TickType, ThisTickFunction);
+	DeferredDeltaTime = 0.f;
+
+	//Super 末尾的 ScheduleNextTick 会按行为树需要重设间隔，这里再抬到 LOD 间隔
+	ClampTickIntervalToLOD();
+
+	if (AILODSubsystem)
+	{
+		AILODSubsystem->AddFrameAITime(FPlatformTime::Seconds() - StartTime);
+	}
+}
+
+void UAuraBehaviorTreeComponent::SetLODTickInterval(float InLODTickInterval)
+{
+	if (LODTickInterval == InLODTickInterval) return;
+
+	//降低间隔时先恢复每帧，下一次 Tick 由行为树自己重新安排
+	if (InLODTickInterval < LODTickInterval && IsComponentTickEnabled())
+	{
+		SetComponentTickIntervalAndCooldown(InLODTickInterval);
+	}
+	LODTickInterval = InLODTickInterval;
+	ClampTickIntervalToLOD();
+}
+
+void UAuraBehaviorTreeComponent::ClampTickIntervalToLOD()
+{
+	//行为树不需要 Tick 时会关掉 Tick，此时保持关闭
+	if (LODTickInterval <= 0.f || !IsComponentTickEnabled()) return;
+
+	if (GetComponentTickInterval() < LODTickInterval)
+	{
+		SetComponentTickIntervalAndCooldown(LODTickInterval);
+	}
+}
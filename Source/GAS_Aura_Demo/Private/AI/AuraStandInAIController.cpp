@@ -0,0 +1,102 @@
+// Copyright Liupingan
+
+
+#include "AI/AuraStandInAIController.h"
+
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AuraGameplayTags.h"
+#include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "Game/AuraCombatantSubsystem.h"
+#include "Interaction/CombatInterface.h"
+
+AAuraStandInAIController::AAuraStandInAIController()
+{
+	//AAuraCharacter 的 ASC 和等级都在 PlayerState 上
+	bWantsPlayerState = true;
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AAuraStandInAIController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ThinkTimeRemaining -= DeltaTime;
+	if (ThinkTimeRemaining <= 0.f)
+	{
+		ThinkTimeRemaining = ThinkInterval;
+		Think();
+	}
+}
+
+void AAuraStandInAIController::OnUnPossess()
+{
+	ReleaseHeldInput();
+	Super::OnUnPossess();
+}
+
+void AAuraStandInAIController::Think()
+{
+	//上一次按下的输入先松开，一按一松对应玩家的一次点击
+	ReleaseHeldInput();
+
+	APawn* ControlledPawn = GetPawn();
+	if (ControlledPawn == nullptr || ICombatInterface::Execute_IsDie(ControlledPawn)) return;
+
+	AActor* Target = FindTarget();
+	if (Target == nullptr)
+	{
+		ClearFocus(EAIFocusPriority::Gameplay);
+		StopMovement();
+		return;
+	}
+
+	//TargetDataUnderMouse 在没有 PlayerController 时以焦点目标作为瞄准点
+	SetFocus(Target);
+	if (FVector::Dist(ControlledPawn->GetActorLocation(), Target->GetActorLocation()) > AttackRange)
+	{
+		MoveToActor(Target, AttackRange * 0.8f);
+		return;
+	}
+
+	StopMovement();
+	if (UAuraAbilitySystemComponent* AuraASC = GetAuraASC())
+	{
+		HeldInputTag = FAuraGameplayTags::Get().InputTag_LMB;
+		AuraASC->AbilityInputTagHeld(HeldInputTag);
+	}
+}
+
+AActor* AAuraStandInAIController::FindTarget() const
+{
+	const UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(this);
+	if (CombatantSubsystem == nullptr) return nullptr;
+
+	APawn* ControlledPawn = GetPawn();
+	TArray<AActor*> Nearest;
+	CombatantSubsystem->GetNearestLiveCombatants(ControlledPawn->GetActorLocation(), 8, SearchRadius, {ControlledPawn}, Nearest);
+	for (AActor* Candidate : Nearest)
+	{
+		if (UAuraAbilitySystemLibrary::IsNotFriend(ControlledPawn, Candidate))
+		{
+			return Candidate;
+		}
+	}
+	return nullptr;
+}
+
+UAuraAbilitySystemComponent* AAuraStandInAIController::GetAuraASC() const
+{
+	return Cast<UAuraAbilitySystemComponent>(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetPawn()));
+}
+
+void AAuraStandInAIController::ReleaseHeldInput()
+{
+	if (!HeldInputTag.IsValid()) return;
+
+	if (UAuraAbilitySystemComponent* AuraASC = GetAuraASC())
+	{
+		AuraASC->AbilityInputTagReleased(HeldInputTag);
+	}
+	HeldInputTag = FGameplayTag();
+}
@@ -6,6 +6,8 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "AuraGameplayTags.h"
+#include "AuraStats.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
 #include "Actor/AuraProjectile.h"
 #include "Interaction/CombatInterface.h"
 
@@ -19,6 +21,8 @@ void UAuraProjectileSpell::ActivateAbility(const FGameplayAbilitySpecHandle Hand
 
 void UAuraProjectileSpell::SpawnProjectile(const FVector& ProjectileTargetLocation, const FGameplayTag& SocketTag)
 {
+	AURA_COMBAT_SCOPE(STAT_AuraSpawnProjectile, AuraProjectiles);
+	LLM_SCOPE_BYTAG(Aura_Projectiles);
 	const bool bIsServer = GetAvatarActorFromActorInfo()->HasAuthority();
 	if (!bIsServer) return;
 
@@ -59,6 +63,7 @@ void UAuraProjectileSpell::SpawnProjectile(const FVector& ProjectileTargetLocati
 	}
 
 	Projectile->DamageEffectSpecHandle = SpecHandle;
+	Projectile->SetTeam(UAuraAbilitySystemLibrary::GetActorTeam(GetAvatarActorFromActorInfo()));
 
 	Projectile->FinishSpawning(SpawnTransform);
 }
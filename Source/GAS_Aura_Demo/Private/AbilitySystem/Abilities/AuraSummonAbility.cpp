@@ -3,3 +3,85 @@
 
 #include "AbilitySystem/Abilities/AuraSummonAbility.h"
 
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "Game/AuraSummonSubsystem.h"
+
+void UAuraSummonAbility::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	Super::OnGiveAbility(ActorInfo, Spec);
+
+	AActor* Avatar = ActorInfo ? ActorInfo->AvatarActor.Get() : nullptr;
+	if (Avatar == nullptr || !Avatar->HasAuthority()) return;
+
+	if (UAuraSummonSubsystem* SummonSubsystem = UAuraSummonSubsystem::Get(Avatar))
+	{
+		SummonSubsystem->RegisterSummoner(Avatar, MinionClasses);
+	}
+}
+
+TArray<FVector> UAuraSummonAbility::GetSpawnLocation()
+{
+	const AActor* Avatar = GetAvatarActorFromActorInfo();
+	const FVector Forward = Avatar->GetActorForwardVector();
+	const FVector Location = Avatar->GetActorLocation();
+
+	//在 SpawnSpread 的扇形内均匀分布
+	const float DeltaSpread = NumMinion > 1 ? SpawnSpread / (NumMinion - 1) : 0.f;
+	const FVector LeftOfSpread = NumMinion > 1 ? Forward.RotateAngleAxis(-SpawnSpread / 2.f, FVector::UpVector) : Forward;
+
+	TArray<FVector> SpawnLocations;
+	SpawnLocations.Reserve(NumMinion);
+	for (int32 Index = 0; Index < NumMinion; ++Index)
+	{
+		const FVector Direction = LeftOfSpread.RotateAngleAxis(DeltaSpread * Index, FVector::UpVector);
+		SpawnLocations.Add(Location + Direction * FMath::FRandRange(MinSpawnDistance, MaxSpawnDistance));
+	}
+
+	//一次批量投影所有点，投影失败的保留原始位置
+	const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSystem ? NavSystem->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (NavData)
+	{
+		TArray<FNavigationProjectionWork> Workload;
+		Workload.Reserve(SpawnLocations.Num());
+		for (const FVector& SpawnLocation : SpawnLocations)
+		{
+			Workload.Emplace(SpawnLocation);
+		}
+		NavData->BatchProjectPoints(Workload, FVector(100.f, 100.f, 400.f));
+
+		for (int32 Index = 0; Index < Workload.Num(); ++Index)
+		{
+			if (Workload[Index].bResult)
+			{
+				SpawnLocations[Index] = Workload[Index].OutLocation.Location;
+			}
+		}
+	}
+	return SpawnLocations;
+}
+
+void UAuraSummonAbility::SpawnMinions()
+{
+	AActor* Avatar = GetAvatarActorFromActorInfo();
+	if (!Avatar->HasAuthority() || MinionClasses.Num() == 0) return;
+
+	UAuraSummonSubsystem* SummonSubsystem = UAuraSummonSubsystem::Get(Avatar);
+	if (SummonSubsystem == nullptr) return;
+
+	const TArray<FVector> SpawnLocations = GetSpawnLocation();
+	const int32 NumToSpawn = FMath::Min(SpawnLocations.Num(), SummonSubsystem->GetRemainingMinionSlots(Avatar));
+	for (int32 Index = 0; Index < NumToSpawn; ++Index)
+	{
+		const TSoftClassPtr<APawn>& MinionClass = MinionClasses[FMath::RandRange(0, MinionClasses.Num() - 1)];
+		const FTransform SpawnTransform(Avatar->GetActorRotation(), SpawnLocations[Index]);
+		SummonSubsystem->RequestSpawn(Avatar, MinionClass, SpawnTransform);
+	}
+}
+
+int32 UAuraSummonAbility::GetNumActiveMinions() const
+{
+	const UAuraSummonSubsystem* SummonSubsystem = UAuraSummonSubsystem::Get(GetAvatarActorFromActorInfo());
+	return SummonSubsystem ? SummonSubsystem->GetNumMinions(GetAvatarActorFromActorInfo()) : 0;
+}
@@ -4,6 +4,8 @@
 #include "AbilitySystem/AbilityTasks/TargetDataUnderMouse.h"
 
 #include "AbilitySystemComponent.h"
+#include "AIController.h"
+#include "Player/AuraPlayerController.h"
 
 UTargetDataUnderMouse* UTargetDataUnderMouse::CreateTargetDataUnderMouse(UGameplayAbility* OwningAbility)
 {
@@ -36,7 +38,24 @@ void UTargetDataUnderMouse::SendMouseCursorData()
 	FScopedPredictionWindow ScopedPrediction(AbilitySystemComponent.Get());
 	APlayerController* PC = Ability->GetCurrentActorInfo()->PlayerController.Get();
 	FHitResult CursorHit;
-	PC->GetHitResultUnderCursor(ECC_Visibility, false, CursorHit);
+	if (const AAuraPlayerController* AuraPC = Cast<AAuraPlayerController>(PC))
+	{
+		AuraPC->GetCursorHitResult(CursorHit);
+	}
+	else if (PC)
+	{
+		PC->GetHitResultUnderCursor(ECC_Visibility, false, CursorHit);
+	}
+	else if (const APawn* AvatarPawn = Cast<APawn>(Ability->GetAvatarActorFromActorInfo()))
+	{
+		//AI 替身（压力测试）没有鼠标，以焦点目标作为命中点
+		const AAIController* AIController = Cast<AAIController>(AvatarPawn->GetController());
+		if (AActor* FocusActor = AIController ? AIController->GetFocusActor() : nullptr)
+		{
+			CursorHit = FHitResult(FocusActor, nullptr, FocusActor->GetActorLocation(), FVector::UpVector);
+			CursorHit.bBlockingHit = true;
+		}
+	}
 
 	FGameplayAbilityTargetData_SingleTargetHit* Data = new FGameplayAbilityTargetData_SingleTargetHit();
 	Data->HitResult = CursorHit;
@@ -4,15 +4,18 @@
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 
 #include "AuraGameplayTags.h"
+#include "AuraStats.h"
+#include "GameplayTagsManager.h"
 #include "AbilitySystem/Abilities/AuraGameplayAbility.h"
 
 void UAuraAbilitySystemComponent::AbilityActorInfoSet()
 {
-	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::ClientEffectApplied);
+	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::EffectAppliedToSelf);
 }
 
 void UAuraAbilitySystemComponent::AddCharacterAbilities(const TArray<TSubclassOf<UGameplayAbility>>& StartupAbilities)
 {
+	LLM_SCOPE_BYTAG(Aura_AbilitySystem);
 	for (const TSubclassOf<UGameplayAbility> AbilityClass : StartupAbilities)
 	{
 		FGameplayAbilitySpec AbilitySpec = FGameplayAbilitySpec(AbilityClass, 1);
@@ -57,11 +60,55 @@ void UAuraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 }
 
 
-void UAuraAbilitySystemComponent::ClientEffectApplied_Implementation(UAbilitySystemComponent* AbilitySystemComponent,
-                                                                     const FGameplayEffectSpec& EffectSpec,
-                                                                     FActiveGameplayEffectHandle ActiveEffectHandle)
+void UAuraAbilitySystemComponent::EffectAppliedToSelf(UAbilitySystemComponent* AbilitySystemComponent,
+                                                      const FGameplayEffectSpec& EffectSpec,
+                                                      FActiveGameplayEffectHandle ActiveEffectHandle)
 {
+	AuraStats::EffectApplied();
+
+	//客户端预测的效果不处理，统一由服务器通知；没有玩家控制器（敌人）也无需通知
+	if (!IsOwnerActorAuthoritative()) return;
+	if (!AbilityActorInfo.IsValid() || !AbilityActorInfo->PlayerController.IsValid()) return;
+
 	FGameplayTagContainer TagContainer;
 	EffectSpec.GetAllAssetTags(TagContainer);
-	EffectAssetTags.Broadcast(TagContainer);
+
+	const FGameplayTag& MessageTag = FAuraGameplayTags::Get().Message;
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	for (const FGameplayTag& Tag : TagContainer)
+	{
+		if (Tag.MatchesTag(MessageTag))
+		{
+			PendingEffectAssetTagIndices.Add(TagsManager.GetNetIndexFromTag(Tag));
+		}
+	}
+
+	//回复、初始化、伤害等不带UI标签的效果到此为止，不产生RPC
+	if (PendingEffectAssetTagIndices.Num() > 0 && !bEffectAssetTagsFlushPending)
+	{
+		bEffectAssetTagsFlushPending = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UAuraAbilitySystemComponent::FlushPendingEffectAssetTags);
+	}
+}
+
+void UAuraAbilitySystemComponent::FlushPendingEffectAssetTags()
+{
+	bEffectAssetTagsFlushPending = false;
+	if (PendingEffectAssetTagIndices.Num() == 0) return;
+
+	ClientEffectAssetTagsApplied(PendingEffectAssetTagIndices);
+	PendingEffectAssetTagIndices.Reset();
+}
+
+void UAuraAbilitySystemComponent::ClientEffectAssetTagsApplied_Implementation(const TArray<uint16>& TagNetIndices)
+{
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	for (const uint16 NetIndex : TagNetIndices)
+	{
+		const FGameplayTag Tag = TagsManager.GetTagFromNetIndex(NetIndex);
+		if (!Tag.IsValid()) continue;
+
+		//每个效果标签单独广播，同帧内两次相同的拾取仍会显示两条消息
+		EffectAssetTags.Broadcast(FGameplayTagContainer(Tag));
+	}
 }
@@ -5,10 +5,15 @@
 
 #include "AbilitySystemComponent.h"
 #include "AuraAbilityTypes.h"
+#include "AuraStats.h"
+#include "AbilitySystem/AuraAttributeSet.h"
 #include "Engine/SceneCapture2D.h"
 #include "Kismet/GameplayStatics.h"
 #include "Player/AuraPlayerState.h"
 #include "Game/AuraGameModeBase.h"
+#include "Game/AuraCharacterClassSubsystem.h"
+#include "Game/AuraCombatantSubsystem.h"
+#include "GAS_Aura_Demo/GAS_Aura_Demo.h"
 #include "Interaction/CombatInterface.h"
 #include "UI/HUD/AuraHUD.h"
 #include "UI/WidgetController/AuraWidgetController.h"
@@ -51,6 +56,7 @@ void UAuraAbilitySystemLibrary::InitializeDefaultAttributes(const UObject* World
                                                             float Level,
                                                             UAbilitySystemComponent* ASC)
 {
+	LLM_SCOPE_BYTAG(Aura_AbilitySystem);
 	UCharacterClassInfo* CharacterClassInfo = GetCharacterClassInfo(WorldContextObject);
 
 	FCharacterClassDefaultInfo CharacterClassDefaultInfo = CharacterClassInfo->GetCharacterClassInfo(CharacterClass);
@@ -68,6 +74,15 @@ void UAuraAbilitySystemLibrary::InitializeDefaultAttributes(const UObject* World
 		CharacterClassInfo->SecondaryAttributes, Level, SecondaryAttributesContextHandle);
 	ASC->ApplyGameplayEffectSpecToSelf(*SecondaryAttributesSpecHandle.Data.Get());
 
+	//生命/法力初始值读取 MaxHealth/MaxMana，先把全部派生属性算好
+	for (UAttributeSet* AttributeSet : ASC->GetSpawnedAttributes())
+	{
+		if (UAuraAttributeSet* AuraAttributeSet = Cast<UAuraAttributeSet>(AttributeSet))
+		{
+			AuraAttributeSet->RecomputeAllDerivedAttributes();
+		}
+	}
+
 	FGameplayEffectContextHandle VitalAttributesContextHandle = ASC->MakeEffectContext();
 	VitalAttributesContextHandle.AddSourceObject(AvatarActor);
 	const FGameplayEffectSpecHandle VitalAttributesSpecHandle = ASC->MakeOutgoingSpec(
@@ -77,6 +92,7 @@ void UAuraAbilitySystemLibrary::InitializeDefaultAttributes(const UObject* World
 
 void UAuraAbilitySystemLibrary::GiveStartupAbilities(const UObject* WorldContextObject, ECharacterClass CharacterClass, UAbilitySystemComponent* ASC)
 {
+	LLM_SCOPE_BYTAG(Aura_AbilitySystem);
 	UCharacterClassInfo* CharacterClassInfo = GetCharacterClassInfo(WorldContextObject);
 	if (CharacterClassInfo == nullptr) return;
 
@@ -99,8 +115,20 @@ void UAuraAbilitySystemLibrary::GiveStartupAbilities(const UObject* WorldContext
 
 UCharacterClassInfo* UAuraAbilitySystemLibrary::GetCharacterClassInfo(const UObject* WorldContextObject)
 {
+	UAuraCharacterClassSubsystem* CharacterClassSubsystem = UAuraCharacterClassSubsystem::Get(WorldContextObject);
+	if (CharacterClassSubsystem && CharacterClassSubsystem->GetCharacterClassInfo())
+	{
+		return CharacterClassSubsystem->GetCharacterClassInfo();
+	}
+
+	//子系统未配置资产时回退到 GameMode（仅服务器），并缓存到子系统
 	AAuraGameModeBase* AuraGameModeBase = Cast<AAuraGameModeBase>(UGameplayStatics::GetGameMode(WorldContextObject));
-	return AuraGameModeBase ? AuraGameModeBase->CharacterClassInfo : nullptr;
+	UCharacterClassInfo* CharacterClassInfo = AuraGameModeBase ? AuraGameModeBase->CharacterClassInfo : nullptr;
+	if (CharacterClassSubsystem && CharacterClassInfo)
+	{
+		CharacterClassSubsystem->SetCharacterClassInfo(CharacterClassInfo);
+	}
+	return CharacterClassInfo;
 }
 
 bool UAuraAbilitySystemLibrary::IsBlockedHit(const FGameplayEffectContextHandle& EffectContextHandle)
@@ -140,6 +168,13 @@ void UAuraAbilitySystemLibrary::SetIsCriticalHit(FGameplayEffectContextHandle& E
 void UAuraAbilitySystemLibrary::GetLivePlayerWithinRadius(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors,
                                                           const TArray<AActor*>& ActorsToIgnore, float Radius, const FVector& SphereOrigin)
 {
+	//游戏世界走战斗者网格索引，不触碰物理场景
+	if (const UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(WorldContextObject))
+	{
+		CombatantSubsystem->GetLiveCombatantsInRadius(SphereOrigin, Radius, ActorsToIgnore, OutOverlappingActors);
+		return;
+	}
+
 	FCollisionQueryParams SphereParams;
 	SphereParams.AddIgnoredActors(ActorsToIgnore);
 
@@ -159,10 +194,54 @@ void UAuraAbilitySystemLibrary::GetLivePlayerWithinRadius(const UObject* WorldCo
 	}
 }
 
+void UAuraAbilitySystemLibrary::GetLiveCombatantsInCone(const UObject* WorldContextObject, TArray<AActor*>& OutActors, const TArray<AActor*>& ActorsToIgnore,
+                                                        const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees)
+{
+	if (const UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(WorldContextObject))
+	{
+		CombatantSubsystem->GetLiveCombatantsInCone(Origin, Direction, Radius, HalfAngleDegrees, ActorsToIgnore, OutActors);
+	}
+}
+
+void UAuraAbilitySystemLibrary::GetNearestLiveCombatants(const UObject* WorldContextObject, TArray<AActor*>& OutActors, const TArray<AActor*>& ActorsToIgnore,
+                                                         const FVector& Origin, int32 Count, float MaxRadius)
+{
+	if (const UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(WorldContextObject))
+	{
+		CombatantSubsystem->GetNearestLiveCombatants(Origin, Count, MaxRadius, ActorsToIgnore, OutActors);
+	}
+}
+
 bool UAuraAbilitySystemLibrary::IsNotFriend(AActor* FirstActor, AActor* SecondActor)
 {
-	const bool bBothPlayer = FirstActor->ActorHasTag(FName("Player")) && SecondActor->ActorHasTag(FName("Player"));
-	const bool bBothEnemy = FirstActor->ActorHasTag(FName("Enemy")) && SecondActor->ActorHasTag(FName("Enemy"));
-	const bool bIsFriend = bBothPlayer || bBothEnemy;
-	return !bIsFriend;
+	return !AreTeamsFriendly(GetActorTeam(FirstActor), GetActorTeam(SecondActor));
+}
+
+EAuraTeam UAuraAbilitySystemLibrary::GetActorTeam(const AActor* Actor)
+{
+	if (const ICombatInterface* CombatInterface = Cast<ICombatInterface>(Actor))
+	{
+		return CombatInterface->GetTeam();
+	}
+	return EAuraTeam::Neutral;
+}
+
+bool UAuraAbilitySystemLibrary::AreTeamsFriendly(EAuraTeam FirstTeam, EAuraTeam SecondTeam)
+{
+	//阵营关系矩阵：[A][B] 为 true 表示友方，中立与任何阵营都不是友方
+	static constexpr bool AffiliationMatrix[static_cast<uint8>(EAuraTeam::MAX)][static_cast<uint8>(EAuraTeam::MAX)] =
+	{
+		/* Neutral */ {false, false, false},
+		/* Player  */ {false, true, false},
+		/* Enemy   */ {false, false, true},
+	};
+	const uint8 First = static_cast<uint8>(FirstTeam);
+	const uint8 Second = static_cast<uint8>(SecondTeam);
+	if (First >= static_cast<uint8>(EAuraTeam::MAX) || Second >= static_cast<uint8>(EAuraTeam::MAX)) return false;
+	return AffiliationMatrix[First][Second];
+}
+
+ECollisionChannel UAuraAbilitySystemLibrary::GetProjectileChannelForTeam(EAuraTeam Team)
+{
+	return Team == EAuraTeam::Enemy ? ECC_EnemyProjectile : ECC_Projectile;
 }
@@ -5,13 +5,36 @@
 
 
 #include "AbilitySystemBlueprintLibrary.h"
+#include "AuraAssetManager.h"
 #include "AuraGameplayTags.h"
+#include "AuraStats.h"
+#include "GameplayEffectAggregator.h"
 #include "GameplayEffectExtension.h"
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "AbilitySystem/Data/AttributeFormulaInfo.h"
 #include "GameFramework/Character.h"
 #include "Interaction/CombatInterface.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Player/AuraPlayerController.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+namespace AuraDerivedAttributes
+{
+	//基础值由依赖图写入，Override 修改器（如次要属性效果里的 MMC）不再生效，加减乘除类的增益照常叠加
+	void IgnoreOverrideMods(const FAggregatorEvaluateParameters& EvaluationParameters, const FAggregator* Aggregator)
+	{
+		Aggregator->ForEachMod([](const FAggregatorModInfo& ModInfo)
+		{
+			if (ModInfo.Op == EGameplayModOp::Override)
+			{
+				ModInfo.Mod->SetExplicitQualifies(false);
+			}
+		});
+	}
+
+	const FAggregatorEvaluateMetaData IgnoreOverrideMetaData(&IgnoreOverrideMods);
+}
 
 UAuraAttributeSet::UAuraAttributeSet()
 {
@@ -43,30 +66,152 @@ UAuraAttributeSet::UAuraAttributeSet()
 void UAuraAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Health, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Mana, COND_None, REPNOTIFY_Always);
 
+	//推送模型：属性只在 PostAttributeChange/PostAttributeBaseChange 标脏后才参与比较
+	FDoRepLifetimeParams Params;
+	Params.Condition = COND_None;
+	Params.RepNotifyCondition = REPNOTIFY_Always;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, Health, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, Mana, Params);
+
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, Strength, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, Intelligence, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, Resilience, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, Vigor, Params);
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, Armor, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, ArmorPenetration, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, BlockChance, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, CriticalHitChance, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, CriticalHitDamage, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, CriticalHitResistance, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, HealthRegeneration, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, ManaRegeneration, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, MaxHealth, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, MaxMana, Params);
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, FireResistance, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, LightingResistance, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, ArcaneResistance, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAuraAttributeSet, PhysicalResistance, Params);
+}
+
+void UAuraAttributeSet::PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const
+{
+	Super::PostAttributeBaseChange(Attribute, OldValue, NewValue);
+	MarkAttributeDirty(Attribute);
+}
+
+void UAuraAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+	MarkAttributeDirty(Attribute);
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Strength, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Intelligence, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Resilience, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Vigor, COND_None, REPNOTIFY_Always);
+	if (OldValue != NewValue)
+	{
+		MarkDerivedAttributesDirty(UAuraAssetManager::GetAttributeFormulaInfo().GetDependentFormulas(Attribute));
+	}
+}
+
+void UAuraAttributeSet::OnAttributeAggregatorCreated(const FGameplayAttribute& Attribute, FAggregator* NewAggregator) const
+{
+	Super::OnAttributeAggregatorCreated(Attribute, NewAggregator);
+
+	if (UAuraAssetManager::GetAttributeFormulaInfo().FindFormula(Attribute) != nullptr)
+	{
+		NewAggregator->EvaluationMetaData = &AuraDerivedAttributes::IgnoreOverrideMetaData;
+	}
+}
+
+void UAuraAttributeSet::MarkLevelDirty()
+{
+	bLevelChanged = true;
+	MarkDerivedAttributesDirty(UAuraAssetManager::GetAttributeFormulaInfo().GetLevelDependentFormulas());
+}
+
+void UAuraAttributeSet::MarkDerivedAttributesDirty(uint64 Formulas)
+{
+	//派生属性只在服务器上计算，客户端通过属性复制拿到结果
+	if (Formulas == 0 || !GetOwningActor()->HasAuthority()) return;
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Armor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, ArmorPenetration, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, BlockChance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, CriticalHitChance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, CriticalHitDamage, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, CriticalHitResistance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, HealthRegeneration, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, ManaRegeneration, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, MaxHealth, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, MaxMana, COND_None, REPNOTIFY_Always);
+	DirtyDerivedAttributes |= Formulas;
 
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, FireResistance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, LightingResistance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, ArcaneResistance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, PhysicalResistance, COND_None, REPNOTIFY_Always);
+	//刷新过程中被标脏的下游排在当前属性之后，同一遍就会处理
+	if (bFlushingDerivedAttributes || bDerivedAttributesFlushPending) return;
+
+	if (UWorld* World = GetWorld())
+	{
+		bDerivedAttributesFlushPending = true;
+		World->GetTimerManager().SetTimerForNextTick(this, &UAuraAttributeSet::FlushDerivedAttributes);
+	}
+	else
+	{
+		FlushDerivedAttributes();
+	}
+}
+
+void UAuraAttributeSet::RecomputeAllDerivedAttributes()
+{
+	DirtyDerivedAttributes |= UAuraAssetManager::GetAttributeFormulaInfo().GetAllFormulas();
+	FlushDerivedAttributes();
+}
+
+void UAuraAttributeSet::FlushDerivedAttributes()
+{
+	AURA_COMBAT_SCOPE(STAT_AuraDerivedAttributesFlush, AuraGAS);
+	bDerivedAttributesFlushPending = false;
+	UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	if (DirtyDerivedAttributes == 0 || ASC == nullptr) return;
+
+	float Level = 1.f;
+	if (ICombatInterface* CombatInterface = Cast<ICombatInterface>(ASC->GetAvatarActor()))
+	{
+		Level = CombatInterface->GetPlayerLevel();
+	}
+
+	const TConstArrayView<FAuraCompiledAttributeFormula> Formulas = UAuraAssetManager::GetAttributeFormulaInfo().GetFormulas();
+	TGuardValue<bool> FlushGuard(bFlushingDerivedAttributes, true);
+	int32 NumRecomputed = 0;
+	for (int32 Index = 0; Index < Formulas.Num() && DirtyDerivedAttributes != 0; ++Index)
+	{
+		const uint64 Bit = uint64(1) << Index;
+		if ((DirtyDerivedAttributes & Bit) == 0) continue;
+		DirtyDerivedAttributes &= ~Bit;
+
+		//与 UMMC_AttributeFormula 一致，输入先截到 0 以上
+		const FAuraCompiledAttributeFormula& Formula = Formulas[Index];
+		float CapturedValues[FAuraCompiledAttributeFormula::MaxCaptures];
+		for (int32 Slot = 0; Slot < Formula.Captures.Num(); ++Slot)
+		{
+			CapturedValues[Slot] = FMath::Max(Formula.Captures[Slot].AttributeToCapture.GetNumericValue(this), 0.f);
+		}
+
+		//当前值变化时 PostAttributeChange 会继续标脏依赖它的公式
+		ASC->SetNumericAttributeBase(Formula.Attribute, Formula.Evaluate(CapturedValues, Level));
+		++NumRecomputed;
+	}
+	DirtyDerivedAttributes = 0;
+	AuraStats::DerivedAttributesRecomputed(NumRecomputed);
+
+	if (bLevelChanged)
+	{
+		bLevelChanged = false;
+		TRACE_BOOKMARK(TEXT("Aura LevelUp %s"), *GetNameSafe(ASC->GetAvatarActor()));
+		UE_LOG(LogTemp, Log, TEXT("%s reached level %d: recomputed %d of %d derived attributes"),
+		       *GetNameSafe(ASC->GetAvatarActor()), static_cast<int32>(Level), NumRecomputed, Formulas.Num());
+	}
+}
+
+void UAuraAttributeSet::MarkAttributeDirty(const FGameplayAttribute& Attribute) const
+{
+	//FGameplayAttributeData 同时携带 Base 与 Current，任意一个变化都需要重新复制
+	if (FProperty* Property = Attribute.GetUProperty())
+	{
+		MARK_PROPERTY_DIRTY(this, Property);
+	}
 }
 
 void UAuraAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
@@ -119,6 +264,7 @@ void UAuraAttributeSet::SetEffectProperties(const struct FGameplayEffectModCallb
 
 void UAuraAttributeSet::PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data)
 {
+	AURA_COMBAT_SCOPE(STAT_AuraPostGameplayEffectExecute, AuraGAS);
 	Super::PostGameplayEffectExecute(Data);
 
 	FEffectProperties Props;
@@ -171,13 +317,13 @@ void UAuraAttributeSet::ShowFloatingText(const FEffectProperties& Props, float D
 		//若伤害来源是玩家【伤害数始终显示在PlayerController上】
 		if (AAuraPlayerController* PC = Cast<AAuraPlayerController>(Props.SourceCharacter->Controller))
 		{
-			PC->ShowDamageNumber(Damage, Props.TargetCharacter, bIsBlockedHit, bIsCriticalHit);
+			PC->QueueDamageNumber(Damage, Props.TargetCharacter, bIsBlockedHit, bIsCriticalHit);
 			return;
 		}
 		//若伤害来源是敌人【伤害数始终显示在PlayerController上】
 		if (AAuraPlayerController* PC = Cast<AAuraPlayerController>(Props.TargetCharacter->Controller))
 		{
-			PC->ShowDamageNumber(Damage, Props.TargetCharacter, bIsBlockedHit, bIsCriticalHit);
+			PC->QueueDamageNumber(Damage, Props.TargetCharacter, bIsBlockedHit, bIsCriticalHit);
 		}
 	}
 }
@@ -0,0 +1,472 @@
+// Copyright Liupingan
+
+
+#include "AbilitySystem/Data/AttributeFormulaInfo.h"
+
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "Algo/AllOf.h"
+
+namespace AttributeFormula
+{
+	using EOp = FAuraCompiledAttributeFormula::EOp;
+	using FInstruction = FAuraCompiledAttributeFormula::FInstruction;
+
+	FORCEINLINE float ApplyBinary(EOp Op, float A, float B)
+	{
+		switch (Op)
+		{
+		case EOp::Add: return A + B;
+		case EOp::Subtract: return A - B;
+		case EOp::Multiply: return A * B;
+		case EOp::Divide: return B != 0.f ? A / B : 0.f;
+		case EOp::Min: return FMath::Min(A, B);
+		case EOp::Max: return FMath::Max(A, B);
+		default: checkNoEntry(); return 0.f;
+		}
+	}
+
+	/**
+	 * 递归下降解析，边解析边输出逆波兰指令；操作数都是常量的运算在编译期折叠
+	 * Expression := Term (('+' | '-') Term)*
+	 * Term       := Unary (('*' | '/') Unary)*
+	 * Unary      := '-' Unary | Primary
+	 * Primary    := Number | Identifier | ('min' | 'max') '(' Expression ',' Expression ')' | '(' Expression ')'
+	 */
+	class FCompiler
+	{
+	public:
+		FCompiler(const FString& InExpression, FAuraCompiledAttributeFormula& OutFormula)
+			: Expression(InExpression), Formula(OutFormula)
+		{
+		}
+
+		bool Compile()
+		{
+			ParseExpression();
+			SkipWhitespace();
+			if (Error.IsEmpty() && Position < Expression.Len())
+			{
+				Fail(TEXT("unexpected character"));
+			}
+			return Error.IsEmpty();
+		}
+
+		const FString& GetError() const { return Error; }
+		int32 GetErrorColumn() const { return Position + 1; }
+
+	private:
+		void ParseExpression()
+		{
+			ParseTerm();
+			while (Error.IsEmpty())
+			{
+				if (Match(TEXT('+'))) { ParseTerm(); Emit(EOp::Add); }
+				else if (Match(TEXT('-'))) { ParseTerm(); Emit(EOp::Subtract); }
+				else break;
+			}
+		}
+
+		void ParseTerm()
+		{
+			ParseUnary();
+			while (Error.IsEmpty())
+			{
+				if (Match(TEXT('*'))) { ParseUnary(); Emit(EOp::Multiply); }
+				else if (Match(TEXT('/'))) { ParseUnary(); Emit(EOp::Divide); }
+				else break;
+			}
+		}
+
+		void ParseUnary()
+		{
+			if (Match(TEXT('-')))
+			{
+				ParseUnary();
+				Emit(EOp::Negate);
+				return;
+			}
+			ParsePrimary();
+		}
+
+		void ParsePrimary()
+		{
+			if (!Error.IsEmpty()) return;
+			SkipWhitespace();
+			if (Position >= Expression.Len())
+			{
+				Fail(TEXT("unexpected end of expression"));
+				return;
+			}
+
+			const TCHAR Char = Expression[Position];
+			if (Match(TEXT('(')))
+			{
+				ParseExpression();
+				Expect(TEXT(')'));
+			}
+			else if (FChar::IsDigit(Char) || Char == TEXT('.'))
+			{
+				ParseNumber();
+			}
+			else if (FChar::IsAlpha(Char) || Char == TEXT('_'))
+			{
+				ParseIdentifier();
+			}
+			else
+			{
+				Fail(TEXT("unexpected character"));
+			}
+		}
+
+		void ParseNumber()
+		{
+			const int32 Start = Position;
+			while (Position < Expression.Len() && (FChar::IsDigit(Expression[Position]) || Expression[Position] == TEXT('.')))
+			{
+				++Position;
+			}
+			const FString Number = Expression.Mid(Start, Position - Start);
+			if (!Number.IsNumeric())
+			{
+				Position = Start;
+				Fail(TEXT("malformed number"));
+				return;
+			}
+			EmitConstant(FCString::Atof(*Number));
+		}
+
+		void ParseIdentifier()
+		{
+			const int32 Start = Position;
+			while (Position < Expression.Len() && (FChar::IsAlnum(Expression[Position]) || Expression[Position] == TEXT('_')))
+			{
+				++Position;
+			}
+			const FString Name = Expression.Mid(Start, Position - Start);
+
+			if (Name.Equals(TEXT("min"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("max"), ESearchCase::IgnoreCase))
+			{
+				const EOp Op = Name.Equals(TEXT("min"), ESearchCase::IgnoreCase) ? EOp::Min : EOp::Max;
+				Expect(TEXT('('));
+				ParseExpression();
+				Expect(TEXT(','));
+				ParseExpression();
+				Expect(TEXT(')'));
+				Emit(Op);
+			}
+			else if (Name.Equals(TEXT("Level"), ESearchCase::IgnoreCase))
+			{
+				Formula.bUsesLevel = true;
+				FInstruction Instruction;
+				Instruction.Op = EOp::Level;
+				Push(Instruction);
+			}
+			else
+			{
+				EmitCapture(Name, Start);
+			}
+		}
+
+		void EmitConstant(float Value)
+		{
+			FInstruction Instruction;
+			Instruction.Op = EOp::Constant;
+			Instruction.Constant = Value;
+			Push(Instruction);
+		}
+
+		void EmitCapture(const FString& Name, int32 NameStart)
+		{
+			FProperty* Property = FindFProperty<FProperty>(UAuraAttributeSet::StaticClass(), *Name);
+			if (Property == nullptr || !FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+			{
+				Position = NameStart;
+				Fail(FString::Printf(TEXT("unknown attribute '%s'"), *Name));
+				return;
+			}
+
+			//同一属性只捕获一次，多次引用共用一个槽位
+			const FGameplayAttribute Attribute(Property);
+			int32 Slot = Formula.Captures.IndexOfByPredicate([&Attribute](const FGameplayEffectAttributeCaptureDefinition& Capture)
+			{
+				return Capture.AttributeToCapture == Attribute;
+			});
+			if (Slot == INDEX_NONE)
+			{
+				if (Formula.Captures.Num() >= FAuraCompiledAttributeFormula::MaxCaptures)
+				{
+					Fail(TEXT("too many captured attributes"));
+					return;
+				}
+				//派生属性由 UAuraAttributeSet 的依赖图保持最新，快照捕获避免 GAS 在输入变化时重算整条效果
+				Slot = Formula.Captures.Emplace(Attribute, EGameplayEffectAttributeCaptureSource::Target, true);
+			}
+
+			FInstruction Instruction;
+			Instruction.Op = EOp::Capture;
+			Instruction.Slot = static_cast<uint8>(Slot);
+			Push(Instruction);
+		}
+
+		void Emit(EOp Op)
+		{
+			if (!Error.IsEmpty()) return;
+			TArray<FInstruction>& Code = Formula.Code;
+
+			if (Op == EOp::Negate)
+			{
+				if (Code.Last().Op == EOp::Constant)
+				{
+					Code.Last().Constant = -Code.Last().Constant;
+					return;
+				}
+				FInstruction Instruction;
+				Instruction.Op = Op;
+				Code.Add(Instruction);
+				return;
+			}
+
+			//二元运算：弹出两个、压入一个
+			--StackDepth;
+			const int32 Num = Code.Num();
+			if (Code[Num - 2].Op == EOp::Constant && Code[Num - 1].Op == EOp::Constant)
+			{
+				Code[Num - 2].Constant = ApplyBinary(Op, Code[Num - 2].Constant, Code[Num - 1].Constant);
+				Code.RemoveAt(Num - 1, 1, EAllowShrinking::No);
+				return;
+			}
+			FInstruction Instruction;
+			Instruction.Op = Op;
+			Code.Add(Instruction);
+		}
+
+		void Push(const FInstruction& Instruction)
+		{
+			if (++StackDepth > FAuraCompiledAttributeFormula::MaxStackDepth)
+			{
+				Fail(TEXT("expression nests too deeply"));
+				return;
+			}
+			Formula.Code.Add(Instruction);
+		}
+
+		void SkipWhitespace()
+		{
+			while (Position < Expression.Len() && FChar::IsWhitespace(Expression[Position]))
+			{
+				++Position;
+			}
+		}
+
+		bool Match(TCHAR Char)
+		{
+			SkipWhitespace();
+			if (Error.IsEmpty() && Position < Expression.Len() && Expression[Position] == Char)
+			{
+				++Position;
+				return true;
+			}
+			return false;
+		}
+
+		void Expect(TCHAR Char)
+		{
+			if (Error.IsEmpty() && !Match(Char))
+			{
+				Fail(FString::Printf(TEXT("expected '%c'"), Char));
+			}
+		}
+
+		void Fail(const FString& Message)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = Message;
+			}
+		}
+
+		const FString& Expression;
+		FAuraCompiledAttributeFormula& Formula;
+		FString Error;
+		int32 Position = 0;
+		int32 StackDepth = 0;
+	};
+}
+
+float FAuraCompiledAttributeFormula::Evaluate(const float* CapturedValues, float Level) const
+{
+	float Stack[MaxStackDepth];
+	int32 Top = -1;
+	for (const FInstruction& Instruction : Code)
+	{
+		switch (Instruction.Op)
+		{
+		case EOp::Constant: Stack[++Top] = Instruction.Constant; break;
+		case EOp::Capture: Stack[++Top] = CapturedValues[Instruction.Slot]; break;
+		case EOp::Level: Stack[++Top] = Level; break;
+		case EOp::Negate: Stack[Top] = -Stack[Top]; break;
+		default:
+			--Top;
+			Stack[Top] = AttributeFormula::ApplyBinary(Instruction.Op, Stack[Top], Stack[Top + 1]);
+			break;
+		}
+	}
+	return Top == 0 ? Stack[0] : 0.f;
+}
+
+UAttributeFormulaInfo::UAttributeFormulaInfo()
+{
+	FAuraAttributeFormula& MaxHealth = AttributeFormulas.AddDefaulted_GetRef();
+	MaxHealth.Attribute = UAuraAttributeSet::GetMaxHealthAttribute();
+	MaxHealth.Expression = TEXT("80 + 2.5 * Vigor + 10 * Level");
+
+	FAuraAttributeFormula& MaxMana = AttributeFormulas.AddDefaulted_GetRef();
+	MaxMana.Attribute = UAuraAttributeSet::GetMaxManaAttribute();
+	MaxMana.Expression = TEXT("50 + 2 * Intelligence + 10 * Level");
+}
+
+void UAttributeFormulaInfo::PostInitProperties()
+{
+	Super::PostInitProperties();
+	CompileFormulas();
+}
+
+void UAttributeFormulaInfo::PostLoad()
+{
+	Super::PostLoad();
+	CompileFormulas();
+}
+
+#if WITH_EDITOR
+void UAttributeFormulaInfo::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	CompileFormulas();
+}
+#endif
+
+const FAuraCompiledAttributeFormula* UAttributeFormulaInfo::FindFormula(const FGameplayAttribute& Attribute) const
+{
+	//公式只有寥寥几条，线性查找比哈希更快
+	for (const FAuraCompiledAttributeFormula& Formula : CompiledFormulas)
+	{
+		if (Formula.Attribute == Attribute)
+		{
+			return &Formula;
+		}
+	}
+	return nullptr;
+}
+
+uint64 UAttributeFormulaInfo::GetDependentFormulas(const FGameplayAttribute& Attribute) const
+{
+	const uint64* Formulas = DependentFormulasByAttribute.Find(Attribute);
+	return Formulas ? *Formulas : 0;
+}
+
+void UAttributeFormulaInfo::CompileFormulas()
+{
+	CompiledFormulas.Reset(AttributeFormulas.Num());
+	for (const FAuraAttributeFormula& Formula : AttributeFormulas)
+	{
+		if (!Formula.Attribute.IsValid()) continue;
+		if (FindFormula(Formula.Attribute) != nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Duplicate formula for [%s] on AttributeFormulaInfo [%s] ignored"),
+			       *Formula.Attribute.GetName(), *GetNameSafe(this));
+			continue;
+		}
+		if (CompiledFormulas.Num() >= MaxFormulas)
+		{
+			UE_LOG(LogTemp, Error, TEXT("AttributeFormulaInfo [%s] has more than %d formulas"), *GetNameSafe(this), MaxFormulas);
+			break;
+		}
+
+		FAuraCompiledAttributeFormula Compiled;
+		Compiled.Attribute = Formula.Attribute;
+		AttributeFormula::FCompiler Compiler(Formula.Expression, Compiled);
+		if (!Compiler.Compile())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Formula for [%s] on AttributeFormulaInfo [%s]: %s at column %d in \"%s\""),
+			       *Formula.Attribute.GetName(), *GetNameSafe(this), *Compiler.GetError(), Compiler.GetErrorColumn(),
+			       *Formula.Expression);
+			continue;
+		}
+		CompiledFormulas.Add(MoveTemp(Compiled));
+	}
+
+	SortFormulasByDependency();
+	BuildDependentFormulas();
+}
+
+void UAttributeFormulaInfo::SortFormulasByDependency()
+{
+	//每条公式引用了哪些公式的结果
+	const int32 NumFormulas = CompiledFormulas.Num();
+	TArray<TArray<int32, TInlineAllocator<4>>> Inputs;
+	Inputs.SetNum(NumFormulas);
+	for (int32 Index = 0; Index < NumFormulas; ++Index)
+	{
+		for (const FGameplayEffectAttributeCaptureDefinition& Capture : CompiledFormulas[Index].Captures)
+		{
+			const int32 InputIndex = CompiledFormulas.IndexOfByPredicate([&Capture](const FAuraCompiledAttributeFormula& Formula)
+			{
+				return Formula.Attribute == Capture.AttributeToCapture;
+			});
+			if (InputIndex != INDEX_NONE)
+			{
+				Inputs[Index].Add(InputIndex);
+			}
+		}
+	}
+
+	//反复挑出输入都已就位的公式；一轮没有进展说明剩下的成环
+	TArray<int32> Order;
+	Order.Reserve(NumFormulas);
+	TBitArray<> bPlaced(false, NumFormulas);
+	for (bool bProgress = true; bProgress && Order.Num() < NumFormulas;)
+	{
+		bProgress = false;
+		for (int32 Index = 0; Index < NumFormulas; ++Index)
+		{
+			if (bPlaced[Index]) continue;
+			if (Algo::AllOf(Inputs[Index], [&bPlaced](int32 InputIndex) { return bPlaced[InputIndex]; }))
+			{
+				bPlaced[Index] = true;
+				Order.Add(Index);
+				bProgress = true;
+			}
+		}
+	}
+
+	TArray<FAuraCompiledAttributeFormula> Sorted;
+	Sorted.Reserve(Order.Num());
+	for (int32 Index = 0; Index < NumFormulas; ++Index)
+	{
+		UE_CLOG(!bPlaced[Index], LogTemp, Error, TEXT("Formula for [%s] on AttributeFormulaInfo [%s] is part of a dependency cycle"),
+		        *CompiledFormulas[Index].Attribute.GetName(), *GetNameSafe(this));
+	}
+	for (const int32 Index : Order)
+	{
+		Sorted.Add(MoveTemp(CompiledFormulas[Index]));
+	}
+	CompiledFormulas = MoveTemp(Sorted);
+}
+
+void UAttributeFormulaInfo::BuildDependentFormulas()
+{
+	DependentFormulasByAttribute.Reset();
+	LevelDependentFormulas = 0;
+	for (int32 Index = 0; Index < CompiledFormulas.Num(); ++Index)
+	{
+		const uint64 Bit = uint64(1) << Index;
+		for (const FGameplayEffectAttributeCaptureDefinition& Capture : CompiledFormulas[Index].Captures)
+		{
+			DependentFormulasByAttribute.FindOrAdd(Capture.AttributeToCapture) |= Bit;
+		}
+		if (CompiledFormulas[Index].bUsesLevel)
+		{
+			LevelDependentFormulas |= Bit;
+		}
+	}
+}
@@ -3,18 +3,51 @@
 
 #include "AbilitySystem/Data/AttributeInfo.h"
 
-FAuraAttributeInfo UAttributeInfo::FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bNotFound) const
+void UAttributeInfo::PostLoad()
 {
-	for (const auto& Info:AttributeInformation)
+	Super::PostLoad();
+	BuildAttributeIndex();
+}
+
+#if WITH_EDITOR
+void UAttributeInfo::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	BuildAttributeIndex();
+}
+#endif
+
+void UAttributeInfo::BuildAttributeIndex()
+{
+	AttributeIndexByTag.Reset();
+	AttributeIndexByTag.Reserve(AttributeInformation.Num());
+	for (int32 Index = 0; Index < AttributeInformation.Num(); ++Index)
 	{
-		if (Info.AttributeTag.MatchesTagExact(AttributeTag))
+		const FGameplayTag& Tag = AttributeInformation[Index].AttributeTag;
+		if (Tag.IsValid() && !AttributeIndexByTag.Contains(Tag))
 		{
-			return Info;
+			AttributeIndexByTag.Add(Tag, Index);
 		}
 	}
+}
+
+const FAuraAttributeInfo& UAttributeInfo::FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bNotFound) const
+{
+	static const FAuraAttributeInfo EmptyInfo;
+
+	const int32 Index = FindAttributeInfoIndexForTag(AttributeTag, bNotFound);
+	return Index != INDEX_NONE ? AttributeInformation[Index] : EmptyInfo;
+}
+
+int32 UAttributeInfo::FindAttributeInfoIndexForTag(const FGameplayTag& AttributeTag, bool bNotFound) const
+{
+	if (const int32* Index = AttributeIndexByTag.Find(AttributeTag))
+	{
+		return *Index;
+	}
 	if (bNotFound)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Info for AttributeTag [%s] on AttributeInfo [%s] not found."),*AttributeTag.ToString(),*GetNameSafe(this));
 	}
-	return FAuraAttributeInfo();
+	return INDEX_NONE;
 }
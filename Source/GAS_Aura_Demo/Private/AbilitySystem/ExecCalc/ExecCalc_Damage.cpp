@@ -5,9 +5,11 @@
 
 #include "AbilitySystemComponent.h"
 #include "AuraGameplayTags.h"
+#include "AuraStats.h"
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
 #include "AbilitySystem/AuraAttributeSet.h"
 #include "AbilitySystem/Data/CharacterClassInfo.h"
+#include "Engine/CurveTable.h"
 #include "Interaction/CombatInterface.h"
 
 struct AuraDamageStatics
@@ -23,7 +25,8 @@ struct AuraDamageStatics
 	DECLARE_ATTRIBUTE_CAPTUREDEF(ArcaneResistance)
 	DECLARE_ATTRIBUTE_CAPTUREDEF(PhysicalResistance)
 
-	TMap<FGameplayTag,FGameplayEffectAttributeCaptureDefinition> TagsToCaptureDefs;
+	//按属性族内下标索引，未捕获的属性保持默认（AttributeToCapture 无效）
+	FAuraAttributeTags::TValues<FGameplayEffectAttributeCaptureDefinition> CaptureDefsByTag;
 	
 	AuraDamageStatics()
 	{
@@ -38,17 +41,26 @@ struct AuraDamageStatics
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, ArcaneResistance, Target, false)
 		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, PhysicalResistance, Target, false)
 
-		const FAuraGameplayTags& Tags=FAuraGameplayTags::Get();
-		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_Armor,ArmorDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_ArmorPenetration,ArmorPenetrationDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_BlockChance,BlockChanceDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_CriticalHitChance,CriticalHitChanceDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_CriticalHitDamage,CriticalHitDamageDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Secondary_CriticalHitResistance,CriticalHitResistanceDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Resistance_Fire,FireResistanceDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Resistance_Lighting,LightingResistanceDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Resistance_Arcane,ArcaneResistanceDef);
-		TagsToCaptureDefs.Add(Tags.Attributes_Resistance_Physical,PhysicalResistanceDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Secondary_Armor, ArmorDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Secondary_ArmorPenetration, ArmorPenetrationDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Secondary_BlockChance, BlockChanceDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Secondary_CriticalHitChance, CriticalHitChanceDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Secondary_CriticalHitDamage, CriticalHitDamageDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Secondary_CriticalHitResistance, CriticalHitResistanceDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Resistance_Fire, FireResistanceDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Resistance_Lighting, LightingResistanceDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Resistance_Arcane, ArcaneResistanceDef);
+		SetCaptureDef(EAuraNativeTag::Attributes_Resistance_Physical, PhysicalResistanceDef);
+	}
+
+	void SetCaptureDef(EAuraNativeTag AttributeTag, const FGameplayEffectAttributeCaptureDefinition& CaptureDef)
+	{
+		CaptureDefsByTag[FAuraAttributeTags::ToLocal(AttributeTag)] = CaptureDef;
+	}
+
+	const FGameplayEffectAttributeCaptureDefinition& GetCaptureDef(EAuraNativeTag AttributeTag) const
+	{
+		return CaptureDefsByTag[FAuraAttributeTags::ToLocal(AttributeTag)];
 	}
 };
 
@@ -76,6 +88,7 @@ UExecCalc_Damage::UExecCalc_Damage()
 void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams,
                                               FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
+	AURA_COMBAT_SCOPE(STAT_AuraExecCalcDamage, AuraGAS);
 	const UAbilitySystemComponent* SourceASC = ExecutionParams.GetSourceAbilitySystemComponent();
 	const UAbilitySystemComponent* TargetASC = ExecutionParams.GetTargetAbilitySystemComponent();
 	AActor* SourceAvatar = SourceASC ? SourceASC->GetAvatarActor() : nullptr;
@@ -97,15 +110,16 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 
 	//遍历所有伤害类型 获取由调用者设置的“Damage”量值
 	float Damage = 0.f;
-	for (const TPair<FGameplayTag, FGameplayTag>& Pair : FAuraGameplayTags::Get().DamageTypesToResistances)
+	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
+	for (int32 DamageTypeIndex = 0; DamageTypeIndex < FAuraDamageTypeTags::Num; ++DamageTypeIndex)
 	{
-		const FGameplayTag DamageTypeTag = Pair.Key;
-		const FGameplayTag ResistanceTag = Pair.Value;
-		float DamageTypeValue = Spec.GetSetByCallerMagnitude(DamageTypeTag);
+		const EAuraNativeTag DamageType = FAuraDamageTypeTags::FromLocal(DamageTypeIndex);
+		const EAuraNativeTag ResistanceTag = FAuraGameplayTags::GetResistanceForDamageType(DamageType);
+		float DamageTypeValue = Spec.GetSetByCallerMagnitude(GameplayTags.GetTag(DamageType));
 
-		checkf(AuraDamageStatics().TagsToCaptureDefs.Contains(ResistanceTag),
-		       TEXT("TagsToCaptureDefs doesn't contain Tag:[%s] in ExecCalc_Damage"), *ResistanceTag.ToString());
-		FGameplayEffectAttributeCaptureDefinition ResistanceCaptureDef = AuraDamageStatics().TagsToCaptureDefs[ResistanceTag];
+		const FGameplayEffectAttributeCaptureDefinition& ResistanceCaptureDef = DamageStatics().GetCaptureDef(ResistanceTag);
+		checkf(ResistanceCaptureDef.AttributeToCapture.IsValid(),
+		       TEXT("No capture def for Tag:[%s] in ExecCalc_Damage"), *GameplayTags.GetTag(ResistanceTag).ToString());
 
 		float Resistance = 0.f;
 		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(ResistanceCaptureDef, EvaluateParams, Resistance);
@@ -115,8 +129,12 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 		Damage += DamageTypeValue;
 	}
 	
-	//获取角色职业信息，里面有存储 系数曲线 的表
-	const UCharacterClassInfo* CharacterClassInfo = UAuraAbilitySystemLibrary::GetCharacterClassInfo(SourceAvatar);
+	//获取缓存的 系数曲线；缺失时系数按 1 计算，不丢掉这次伤害
+	const FAuraDamageCoefficientCurves* CoefficientCurves = GetCoefficientCurves(SourceAvatar ? SourceAvatar : TargetAvatar);
+	ensureMsgf(CoefficientCurves, TEXT("ExecCalc_Damage: damage coefficient curves are missing, applying damage without coefficients"));
+	//没有来源战斗者（如场景里放置的效果物）时按效果等级计算
+	const float SourceLevel = SourceCombatInterface ? SourceCombatInterface->GetPlayerLevel() : Spec.GetLevel();
+	const float TargetLevel = TargetCombatInterface ? TargetCombatInterface->GetPlayerLevel() : 1.f;
 	
 	//【捕获】目标格挡几率
 	float TargetBlockChance = 0.f;
@@ -136,10 +154,8 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().ArmorPenetrationDef, EvaluateParams,SourceArmorPenetration);
 	SourceArmorPenetration = FMath::Max(SourceArmorPenetration, 0.f);
 		//取参与伤害计算的系数
-	const FRealCurve* ArmorPenetrationCurve = CharacterClassInfo->DamageCalculationCoefficients->FindCurve(FName("ArmorPenetration"), FString());
-	const float ArmorPenetrationCoefficient = ArmorPenetrationCurve->Eval(SourceCombatInterface->GetPlayerLevel());
-	const FRealCurve* EffectiveArmorCurve = CharacterClassInfo->DamageCalculationCoefficients->FindCurve(FName("EffectiveArmor"), FString());
-	const float EffectiveArmorCoefficient = EffectiveArmorCurve->Eval(TargetCombatInterface->GetPlayerLevel());
+	const float ArmorPenetrationCoefficient = CoefficientCurves ? CoefficientCurves->ArmorPenetration->Eval(SourceLevel) : 1.f;
+	const float EffectiveArmorCoefficient = CoefficientCurves ? CoefficientCurves->EffectiveArmor->Eval(TargetLevel) : 1.f;
 		//计算：穿甲会忽略一定比例的目标护甲值，护甲值会忽略一定比例的伤害
 	const float EffectiveArmor = TargetArmor * (100 - SourceArmorPenetration * ArmorPenetrationCoefficient) / 100.f;
 	Damage *= (100 - EffectiveArmor * EffectiveArmorCoefficient) / 100.f;
@@ -155,9 +171,7 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().CriticalHitResistanceDef,EvaluateParams,TargetCriticalHitResistance);
 	TargetCriticalHitResistance=FMath::Max(TargetCriticalHitResistance,0.f);
 		//取参与伤害计算的系数
-	const FRealCurve* CriticalHitResistanceCurve = CharacterClassInfo->DamageCalculationCoefficients->FindCurve(
-		FName("CriticalHitResistance"), FString());
-	const float CriticalHitResistanceCoefficient = CriticalHitResistanceCurve->Eval(TargetCombatInterface->GetPlayerLevel());
+	const float CriticalHitResistanceCoefficient = CoefficientCurves ? CoefficientCurves->CriticalHitResistance->Eval(TargetLevel) : 1.f;
 		//计算：目标暴击抵抗 按系数削减 源暴击率；暴击时造成两倍伤害，并造成额外的 源暴击伤害
 	const float EffectiveCriticalHitChance = SourceCriticalHitChance - TargetCriticalHitResistance * CriticalHitResistanceCoefficient;
 	const bool bCriticalHit = FMath::RandRange(1, 100) < EffectiveCriticalHitChance;
@@ -170,3 +184,17 @@ void UExecCalc_Damage::Execute_Implementation(const FGameplayEffectCustomExecuti
 	                                                   EGameplayModOp::Additive, Damage);
 	OutExecutionOutput.AddOutputModifier(EvaluatedData);
 }
+
+const FAuraDamageCoefficientCurves* UExecCalc_Damage::GetCoefficientCurves(const UObject* WorldContextObject) const
+{
+	if (!CachedCoefficientTable.IsValid())
+	{
+		const UAuraCharacterClassSubsystem* CharacterClassSubsystem = UAuraCharacterClassSubsystem::Get(WorldContextObject);
+		const UCharacterClassInfo* CharacterClassInfo = CharacterClassSubsystem ? CharacterClassSubsystem->GetCharacterClassInfo() : nullptr;
+		if (CharacterClassInfo == nullptr || !CharacterClassSubsystem->GetDamageCoefficientCurves().IsValid()) return nullptr;
+
+		CachedCoefficientCurves = CharacterClassSubsystem->GetDamageCoefficientCurves();
+		CachedCoefficientTable = CharacterClassInfo->DamageCalculationCoefficients;
+	}
+	return &CachedCoefficientCurves;
+}
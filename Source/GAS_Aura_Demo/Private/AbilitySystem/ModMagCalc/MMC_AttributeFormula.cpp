@@ -0,0 +1,169 @@
+// Copyright Liupingan
+
+
+#include "AbilitySystem/ModMagCalc/MMC_AttributeFormula.h"
+
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AuraAssetManager.h"
+#include "AuraStats.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "AbilitySystem/Data/AttributeFormulaInfo.h"
+#include "AbilitySystem/Data/CharacterClassInfo.h"
+#include "Game/AuraCombatantSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Interaction/CombatInterface.h"
+
+const TArray<FGameplayEffectAttributeCaptureDefinition>& UMMC_AttributeFormula::GetAttributeCaptureDefinitions() const
+{
+	const FAuraCompiledAttributeFormula* Formula = FindFormula();
+	return Formula ? Formula->Captures : Super::GetAttributeCaptureDefinitions();
+}
+
+float UMMC_AttributeFormula::CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const
+{
+	AURA_COMBAT_SCOPE(STAT_AuraMMCAttributeFormula, AuraGAS);
+	const FAuraCompiledAttributeFormula* Formula = FindFormula();
+	if (Formula == nullptr) return 0.f;
+
+	FAggregatorEvaluateParameters EvaluateParameters;
+	EvaluateParameters.SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+	EvaluateParameters.TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+
+	//和原先手写的 MMC 一样，捕获到的属性先截到 0 以上
+	float CapturedValues[FAuraCompiledAttributeFormula::MaxCaptures];
+	for (int32 Slot = 0; Slot < Formula->Captures.Num(); ++Slot)
+	{
+		float& Value = CapturedValues[Slot];
+		Value = 0.f;
+		GetCapturedAttributeMagnitude(Formula->Captures[Slot], Spec, EvaluateParameters, Value);
+		Value = FMath::Max(Value, 0.f);
+	}
+
+	//只有公式用到 Level 时才去取来源的等级，来源不是战斗者时退回效果等级
+	float Level = Spec.GetLevel();
+	if (Formula->bUsesLevel)
+	{
+		if (ICombatInterface* CombatInterface = Cast<ICombatInterface>(Spec.GetEffectContext().GetSourceObject()))
+		{
+			Level = CombatInterface->GetPlayerLevel();
+		}
+	}
+
+	return Formula->Evaluate(CapturedValues, Level);
+}
+
+const FAuraCompiledAttributeFormula* UMMC_AttributeFormula::FindFormula() const
+{
+	return UAuraAssetManager::GetAttributeFormulaInfo().FindFormula(FormulaAttribute);
+}
+
+#if !UE_BUILD_SHIPPING
+namespace AuraFormulaBenchmark
+{
+	using FReferenceFormula = float(*)(const FGameplayEffectSpec& Spec);
+
+	//与公式 MMC 相同的快照捕获，截到 0 以上
+	float CaptureTargetAttribute(const FGameplayEffectSpec& Spec, const FGameplayAttribute& Attribute)
+	{
+		FAggregatorEvaluateParameters EvaluateParameters;
+		EvaluateParameters.SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+		EvaluateParameters.TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+
+		float Value = 0.f;
+		const FGameplayEffectAttributeCaptureDefinition CaptureDef(Attribute, EGameplayEffectAttributeCaptureSource::Target, true);
+		if (const FGameplayEffectAttributeCaptureSpec* CaptureSpec = Spec.CapturedRelevantAttributes.FindCaptureSpecByDefinition(CaptureDef, true))
+		{
+			CaptureSpec->AttemptCalculateAttributeMagnitude(EvaluateParameters, Value);
+		}
+		return FMath::Max(Value, 0.f);
+	}
+
+	float GetSourceLevel(const FGameplayEffectSpec& Spec)
+	{
+		ICombatInterface* CombatInterface = Cast<ICombatInterface>(Spec.GetEffectContext().GetSourceObject());
+		return CombatInterface ? CombatInterface->GetPlayerLevel() : Spec.GetLevel();
+	}
+
+	//手写的对照实现，与 UAttributeFormulaInfo 类默认对象里的默认公式一致
+	float MaxHealth(const FGameplayEffectSpec& Spec)
+	{
+		return 80.f + 2.5f * CaptureTargetAttribute(Spec, UAuraAttributeSet::GetVigorAttribute()) + 10.f * GetSourceLevel(Spec);
+	}
+
+	float MaxMana(const FGameplayEffectSpec& Spec)
+	{
+		return 50.f + 2.f * CaptureTargetAttribute(Spec, UAuraAttributeSet::GetIntelligenceAttribute()) + 10.f * GetSourceLevel(Spec);
+	}
+
+	FReferenceFormula FindReferenceFormula(const FGameplayAttribute& Attribute)
+	{
+		if (Attribute == UAuraAttributeSet::GetMaxHealthAttribute()) return &MaxHealth;
+		if (Attribute == UAuraAttributeSet::GetMaxManaAttribute()) return &MaxMana;
+		return nullptr;
+	}
+}
+
+//在第一个存活战斗者身上构造次要属性效果的 Spec，逐个对比公式 MMC 与手写版本，用法：Aura.Formulas.Benchmark [次数=100000]
+static FAutoConsoleCommandWithWorldAndArgs GAuraFormulasBenchmarkCommand(
+	TEXT("Aura.Formulas.Benchmark"),
+	TEXT("Times each formula MMC in the secondary attributes effect against its hand-written version on a live combatant. Args: [Iterations=100000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations = FMath::Max(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000, 1);
+
+		TArray<AActor*> Combatants;
+		if (const UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(World))
+		{
+			CombatantSubsystem->GetLiveCombatants(Combatants);
+		}
+		UAbilitySystemComponent* ASC = Combatants.Num() > 0 ? UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Combatants[0]) : nullptr;
+		const UCharacterClassInfo* CharacterClassInfo = UAuraAbilitySystemLibrary::GetCharacterClassInfo(World);
+		if (ASC == nullptr || CharacterClassInfo == nullptr || CharacterClassInfo->SecondaryAttributes == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aura.Formulas.Benchmark needs a live combatant and CharacterClassInfo"));
+			return;
+		}
+
+		FGameplayEffectContextHandle ContextHandle = ASC->MakeEffectContext();
+		ContextHandle.AddSourceObject(ASC->GetAvatarActor());
+		const FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(CharacterClassInfo->SecondaryAttributes, 1.f, ContextHandle);
+		FGameplayEffectSpec& Spec = *SpecHandle.Data.Get();
+		Spec.CaptureAttributeDataFromTarget(ASC);
+
+		for (const FGameplayModifierInfo& Modifier : Spec.Def->Modifiers)
+		{
+			const TSubclassOf<UGameplayModMagnitudeCalculation> CalculationClass = Modifier.ModifierMagnitude.GetCustomMagnitudeCalculationClass();
+			const UMMC_AttributeFormula* Calculation = CalculationClass ? Cast<UMMC_AttributeFormula>(CalculationClass->GetDefaultObject()) : nullptr;
+			if (Calculation == nullptr) continue;
+
+			float FormulaValue = 0.f;
+			const double FormulaStart = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				FormulaValue = Calculation->CalculateBaseMagnitude_Implementation(Spec);
+			}
+			const double FormulaNs = (FPlatformTime::Seconds() - FormulaStart) * 1e9 / Iterations;
+
+			const AuraFormulaBenchmark::FReferenceFormula ReferenceFormula = AuraFormulaBenchmark::FindReferenceFormula(Modifier.Attribute);
+			if (ReferenceFormula == nullptr)
+			{
+				UE_LOG(LogTemp, Display, TEXT("%-24s formula %7.1f ns = %.2f (no hand-written version)"),
+				       *Modifier.Attribute.GetName(), FormulaNs, FormulaValue);
+				continue;
+			}
+			float ReferenceValue = 0.f;
+			const double ReferenceStart = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				ReferenceValue = ReferenceFormula(Spec);
+			}
+			const double ReferenceNs = (FPlatformTime::Seconds() - ReferenceStart) * 1e9 / Iterations;
+
+			UE_LOG(LogTemp, Display, TEXT("%-24s formula %7.1f ns = %.2f, hand-written %7.1f ns = %.2f%s"),
+			       *Modifier.Attribute.GetName(), FormulaNs, FormulaValue, ReferenceNs, ReferenceValue,
+			       FMath::IsNearlyEqual(FormulaValue, ReferenceValue, 1.e-3f) ? TEXT("") : TEXT("  MISMATCH"));
+		}
+	}));
+#endif
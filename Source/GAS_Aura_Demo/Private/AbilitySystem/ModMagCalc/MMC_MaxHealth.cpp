@@ -4,32 +4,8 @@
 #include "AbilitySystem/ModMagCalc/MMC_MaxHealth.h"
 
 #include "AbilitySystem/AuraAttributeSet.h"
-#include "Interaction/CombatInterface.h"
 
 UMMC_MaxHealth::UMMC_MaxHealth()
 {
-	VigorDef.AttributeToCapture = UAuraAttributeSet::GetVigorAttribute();
-	VigorDef.AttributeSource = EGameplayEffectAttributeCaptureSource::Target;
-	VigorDef.bSnapshot = false;
-
-	RelevantAttributesToCapture.Add(VigorDef);
-}
-
-float UMMC_MaxHealth::CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const
-{
-	// Gather Source and Target Tags
-	const FGameplayTagContainer* SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
-	const FGameplayTagContainer* TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
-
-	FAggregatorEvaluateParameters EvaluateParameters;
-	EvaluateParameters.SourceTags = SourceTags;
-	EvaluateParameters.TargetTags = TargetTags;
-
-	float Vigor = 0.f;
-	GetCapturedAttributeMagnitude(VigorDef, Spec, EvaluateParameters, Vigor);
-	Vigor = FMath::Max(0.f, Vigor);
-
-	const int32 PlayLevel = Cast<ICombatInterface>(Spec.GetEffectContext().GetSourceObject())->GetPlayerLevel();
-
-	return 80.f + 2.5f * Vigor + 10.f * PlayLevel;
+	FormulaAttribute = UAuraAttributeSet::GetMaxHealthAttribute();
 }
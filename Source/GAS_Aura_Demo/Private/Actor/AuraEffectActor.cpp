@@ -6,6 +6,10 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemInterface.h"
+#include "AuraStats.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "Interaction/CombatInterface.h"
+#include "Misc/DataValidation.h"
 
 
 // Sets default values
@@ -17,15 +21,52 @@ AAuraEffectActor::AAuraEffectActor()
 }
 
 
+#if WITH_EDITOR
+EDataValidationResult AAuraEffectActor::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+	if (AreaGameplayEffectClass && !IsAreaEffectInstant())
+	{
+		Context.AddError(FText::Format(NSLOCTEXT("AuraEffectActor", "AreaEffectNotInstant", "AreaGameplayEffectClass {0} must be an Instant effect"),
+		                               FText::FromString(GetNameSafe(AreaGameplayEffectClass))));
+		Result = EDataValidationResult::Invalid;
+	}
+	return Result;
+}
+#endif
+
 void AAuraEffectActor::BeginPlay()
 {
 	Super::BeginPlay();
+
+	//周期效果按 Instant 设计，持续型效果每个周期都会叠一层且不会在离开时移除，直接禁用
+	if (AreaGameplayEffectClass && !IsAreaEffectInstant())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s: AreaGameplayEffectClass %s is not Instant, area effect disabled"),
+		       *GetName(), *GetNameSafe(AreaGameplayEffectClass));
+		AreaGameplayEffectClass = nullptr;
+	}
+}
+
+bool AAuraEffectActor::IsAreaEffectInstant() const
+{
+	const UGameplayEffect* AreaEffectCDO = AreaGameplayEffectClass ? AreaGameplayEffectClass->GetDefaultObject<UGameplayEffect>() : nullptr;
+	return AreaEffectCDO && AreaEffectCDO->DurationPolicy == EGameplayEffectDurationType::Instant;
+}
+
+void AAuraEffectActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(AreaEffectTimerHandle);
+	AreaOccupants.Empty();
+	AreaLastApplicationTimes.Empty();
+	ActiveEffectHandles.Empty();
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAuraEffectActor::ApplyEffectToTarget(AActor* TargetActor, TSubclassOf<UGameplayEffect> GameplayEffectClass)
 {
 	//目标为敌人 且 不想敌人受到效果物影响时 ，直接返回
-	if ((TargetActor->ActorHasTag(FName("Enemy")) && !bApplyEffectsToEnemy)) return;
+	if (UAuraAbilitySystemLibrary::GetActorTeam(TargetActor) == EAuraTeam::Enemy && !bApplyEffectsToEnemy) return;
 
 	UAbilitySystemComponent* TargetACS = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor);
 	if (TargetACS == nullptr) return;
@@ -42,7 +83,7 @@ void AAuraEffectActor::ApplyEffectToTarget(AActor* TargetActor, TSubclassOf<UGam
 	const bool bIsInfinite = EffectSpecHandle.Data.Get()->Def.Get()->DurationPolicy ==EGameplayEffectDurationType::Infinite;
 	if (bIsInfinite && InfiniteEffectRemovalPolicy ==EEffectRemovalPolicy::RemoveOnEndOverlay)
 	{
-		ActiveEffectHandles.Add(ActiveGameplayEffectHandle, TargetACS);
+		ActiveEffectHandles.Add(TargetACS, ActiveGameplayEffectHandle);
 	}
 	if (!bIsInfinite && bDestroyOnEffectApplication)
 	{
@@ -53,7 +94,7 @@ void AAuraEffectActor::ApplyEffectToTarget(AActor* TargetActor, TSubclassOf<UGam
 void AAuraEffectActor::OnOverlap(AActor* TargetActor)
 {
 	//目标为敌人 且 不想敌人受到效果物影响时 ，直接返回
-	if ((TargetActor->ActorHasTag(FName("Enemy")) && !bApplyEffectsToEnemy)) return;
+	if (UAuraAbilitySystemLibrary::GetActorTeam(TargetActor) == EAuraTeam::Enemy && !bApplyEffectsToEnemy) return;
 
 	if (InstantEffectApplicationPolicy == EEffectApplicationPolicy::ApplyOnOverlay)
 	{
@@ -67,12 +108,16 @@ void AAuraEffectActor::OnOverlap(AActor* TargetActor)
 	{
 		ApplyEffectToTarget(TargetActor, InfiniteGameplayEffectClass);
 	}
+	if (AreaGameplayEffectClass)
+	{
+		AddAreaOccupant(TargetActor);
+	}
 }
 
 void AAuraEffectActor::OnEndOverlap(AActor* TargetActor)
 {
 	//目标为敌人 且 不想敌人受到效果物影响时 ，直接返回
-	if ((TargetActor->ActorHasTag(FName("Enemy")) && !bApplyEffectsToEnemy)) return;
+	if (UAuraAbilitySystemLibrary::GetActorTeam(TargetActor) == EAuraTeam::Enemy && !bApplyEffectsToEnemy) return;
 
 	if (InstantEffectApplicationPolicy == EEffectApplicationPolicy::ApplyOnEndOverlay)
 	{
@@ -86,23 +131,112 @@ void AAuraEffectActor::OnEndOverlap(AActor* TargetActor)
 	{
 		ApplyEffectToTarget(TargetActor, InfiniteGameplayEffectClass);
 	}
+	if (AreaGameplayEffectClass)
+	{
+		RemoveAreaOccupant(TargetActor);
+	}
 	if (InfiniteEffectRemovalPolicy == EEffectRemovalPolicy::RemoveOnEndOverlay)
 	{
 		UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor);
 		if (!IsValid(TargetASC)) return;
 
-		TArray<FActiveGameplayEffectHandle> HandlesToRemove;
-		for (auto HandlePair : ActiveEffectHandles)
+		TArray<FActiveGameplayEffectHandle, TInlineAllocator<4>> HandlesToRemove;
+		ActiveEffectHandles.MultiFind(TargetASC, HandlesToRemove);
+		ActiveEffectHandles.Remove(TargetASC);
+		for (const FActiveGameplayEffectHandle& Handle : HandlesToRemove)
+		{
+			TargetASC->RemoveActiveGameplayEffect(Handle, 1);
+		}
+	}
+}
+
+void AAuraEffectActor::AddAreaOccupant(AActor* TargetActor)
+{
+	if (!HasAuthority()) return;
+
+	UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor);
+	if (TargetASC == nullptr || AreaOccupants.Contains(TargetASC)) return;
+
+	AreaOccupants.Add(TargetASC);
+	//进入时立即施加一次，只是路过的目标也会受到影响；一个周期内刚被施加过（反复进出）的跳过
+	const TWeakObjectPtr<UAbilitySystemComponent> EnteringOccupant(TargetASC);
+	ApplyAreaEffectToOccupants(MakeArrayView(&EnteringOccupant, 1));
+	if (!GetWorldTimerManager().IsTimerActive(AreaEffectTimerHandle))
+	{
+		GetWorldTimerManager().SetTimer(AreaEffectTimerHandle, this, &AAuraEffectActor::ApplyAreaEffect,
+		                                AreaEffectPeriod, true);
+	}
+}
+
+void AAuraEffectActor::RemoveAreaOccupant(AActor* TargetActor)
+{
+	if (!HasAuthority()) return;
+
+	AreaOccupants.RemoveSingleSwap(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor));
+	if (AreaOccupants.IsEmpty())
+	{
+		GetWorldTimerManager().ClearTimer(AreaEffectTimerHandle);
+	}
+}
+
+void AAuraEffectActor::ApplyAreaEffect()
+{
+	AURA_COMBAT_SCOPE(STAT_AuraAreaEffectPulse, AuraGAS);
+
+	//目标被销毁（如回收进对象池）时不一定会触发结束重叠
+	AreaOccupants.RemoveAllSwap([](const TWeakObjectPtr<UAbilitySystemComponent>& Occupant) { return !Occupant.IsValid(); });
+	const double StaleTime = GetWorld()->GetTimeSeconds() - AreaEffectPeriod;
+	for (auto It = AreaLastApplicationTimes.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid() || It->Value < StaleTime)
 		{
-			if (HandlePair.Value == TargetASC)
-			{
-				TargetASC->RemoveActiveGameplayEffect(HandlePair.Key, 1);
-				HandlesToRemove.Add(HandlePair.Key);
-			}
+			It.RemoveCurrent();
 		}
-		for (auto& Handle : HandlesToRemove)
+	}
+	if (AreaOccupants.IsEmpty())
+	{
+		GetWorldTimerManager().ClearTimer(AreaEffectTimerHandle);
+		return;
+	}
+
+	//施加效果可能导致目标死亡并结束重叠，遍历副本
+	const TArray<TWeakObjectPtr<UAbilitySystemComponent>> Occupants = AreaOccupants;
+	ApplyAreaEffectToOccupants(Occupants);
+}
+
+void AAuraEffectActor::ApplyAreaEffectToOccupants(TConstArrayView<TWeakObjectPtr<UAbilitySystemComponent>> Occupants)
+{
+	//发起者有 ASC（如技能生成的火池）时整批共用一个 Spec，施加时 ASC 会各自拷贝并捕获目标属性；
+	//场景里放置的效果物没有发起者，与 ApplyEffectToTarget 一样从目标 ASC 构造，伤害计算总能拿到来源
+	FGameplayEffectSpecHandle SharedSpecHandle;
+	if (UAbilitySystemComponent* InstigatorASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetInstigator()))
+	{
+		SharedSpecHandle = MakeAreaEffectSpec(InstigatorASC);
+	}
+
+	//定时器晚到的那一帧会让两次脉冲的实际间隔略小于周期，留出一帧的误差
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double MinInterval = AreaEffectPeriod - GetWorld()->GetDeltaSeconds();
+	for (const TWeakObjectPtr<UAbilitySystemComponent>& Occupant : Occupants)
+	{
+		UAbilitySystemComponent* TargetASC = Occupant.Get();
+		if (TargetASC == nullptr) continue;
+
+		double& LastApplicationTime = AreaLastApplicationTimes.FindOrAdd(Occupant, -UE_BIG_NUMBER);
+		if (Now - LastApplicationTime < MinInterval) continue;
+		LastApplicationTime = Now;
+
+		const FGameplayEffectSpecHandle SpecHandle = SharedSpecHandle.IsValid() ? SharedSpecHandle : MakeAreaEffectSpec(TargetASC);
+		if (SpecHandle.IsValid())
 		{
-			ActiveEffectHandles.FindAndRemoveChecked(Handle);
+			TargetASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
 		}
 	}
 }
+
+FGameplayEffectSpecHandle AAuraEffectActor::MakeAreaEffectSpec(UAbilitySystemComponent* SourceASC) const
+{
+	FGameplayEffectContextHandle EffectContextHandle = SourceASC->MakeEffectContext();
+	EffectContextHandle.AddSourceObject(this);
+	return SourceASC->MakeOutgoingSpec(AreaGameplayEffectClass, ActorLevel, EffectContextHandle);
+}
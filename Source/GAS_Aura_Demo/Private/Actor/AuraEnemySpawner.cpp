@@ -0,0 +1,162 @@
+// Copyright Liupingan
+
+
+#include "Actor/AuraEnemySpawner.h"
+
+#include "AuraAssetManager.h"
+#include "NavigationSystem.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "Character/AuraEnemy.h"
+#include "Components/SphereComponent.h"
+#include "Engine/StreamableManager.h"
+
+AAuraEnemySpawner::AAuraEnemySpawner()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	SetRootComponent(CreateDefaultSubobject<USceneComponent>("SceneRoot"));
+
+	PreloadSphere = CreateDefaultSubobject<USphereComponent>("PreloadSphere");
+	PreloadSphere->SetupAttachment(GetRootComponent());
+	PreloadSphere->SetSphereRadius(5000.f);
+	PreloadSphere->SetCollisionProfileName(UCollisionProfile::CustomCollisionProfileName);
+	PreloadSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	PreloadSphere->SetCollisionResponseToAllChannels(ECR_Ignore);
+	PreloadSphere->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+
+	ActivationSphere = CreateDefaultSubobject<USphereComponent>("ActivationSphere");
+	ActivationSphere->SetupAttachment(GetRootComponent());
+	ActivationSphere->SetSphereRadius(1500.f);
+	ActivationSphere->SetCollisionProfileName(UCollisionProfile::CustomCollisionProfileName);
+	ActivationSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	ActivationSphere->SetCollisionResponseToAllChannels(ECR_Ignore);
+	ActivationSphere->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+}
+
+void AAuraEnemySpawner::BeginPlay()
+{
+	Super::BeginPlay();
+	if (!HasAuthority()) return;
+
+	PreloadSphere->OnComponentBeginOverlap.AddDynamic(this, &AAuraEnemySpawner::OnPreloadSphereOverlap);
+	ActivationSphere->OnComponentBeginOverlap.AddDynamic(this, &AAuraEnemySpawner::OnActivationSphereOverlap);
+}
+
+void AAuraEnemySpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseEnemyClasses();
+	Super::EndPlay(EndPlayReason);
+}
+
+void AAuraEnemySpawner::OnPreloadSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+                                               UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,
+                                               const FHitResult& SweepResult)
+{
+	if (UAuraAbilitySystemLibrary::GetActorTeam(OtherActor) == EAuraTeam::Player)
+	{
+		PreloadEnemyClasses();
+	}
+}
+
+void AAuraEnemySpawner::OnActivationSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+                                                  UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,
+                                                  const FHitResult& SweepResult)
+{
+	if (UAuraAbilitySystemLibrary::GetActorTeam(OtherActor) == EAuraTeam::Player)
+	{
+		ActivateSpawner();
+	}
+}
+
+void AAuraEnemySpawner::PreloadEnemyClasses()
+{
+	if (bPreloadRequested || !HasAuthority()) return;
+	bPreloadRequested = true;
+
+	//先把计数加满再发请求：已加载的类会立刻回调，不能在请求途中就判定为全部就绪
+	NumPendingLoads = EnemyClasses.Num() + 1;
+	for (const TSoftClassPtr<AAuraEnemy>& EnemyClass : EnemyClasses)
+	{
+		TOptional<ECharacterClass> AcquiredClass;
+		LoadHandles.Add(UAuraAssetManager::Get().RequestEnemyClass(EnemyClass.ToSoftObjectPath(), AcquiredClass,
+			FStreamableDelegate::CreateUObject(this, &AAuraEnemySpawner::OnEnemyClassLoaded)));
+		if (AcquiredClass.IsSet())
+		{
+			AcquiredClasses.Add(AcquiredClass.GetValue());
+		}
+	}
+	OnEnemyClassLoaded();
+}
+
+void AAuraEnemySpawner::ActivateSpawner()
+{
+	if (bActivated || !HasAuthority()) return;
+	bActivated = true;
+
+	PreloadEnemyClasses();
+	if (NumPendingLoads == 0)
+	{
+		SpawnEnemies();
+	}
+}
+
+void AAuraEnemySpawner::OnEnemyClassLoaded()
+{
+	if (--NumPendingLoads == 0 && bActivated)
+	{
+		SpawnEnemies();
+	}
+}
+
+void AAuraEnemySpawner::SpawnEnemies()
+{
+	if (bSpawned) return;
+	bSpawned = true;
+
+	TArray<UClass*> LoadedClasses;
+	for (const TSoftClassPtr<AAuraEnemy>& EnemyClass : EnemyClasses)
+	{
+		if (UClass* LoadedClass = EnemyClass.Get())
+		{
+			LoadedClasses.Add(LoadedClass);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: failed to load enemy class %s"), *GetName(), *EnemyClass.ToString());
+		}
+	}
+
+	const UNavigationSystemV1* NavSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+	for (int32 Index = 0; Index < NumEnemies && LoadedClasses.Num() > 0; ++Index)
+	{
+		FVector Location = GetActorLocation();
+		FNavLocation NavLocation;
+		if (NavSystem && NavSystem->GetRandomReachablePointInRadius(GetActorLocation(), SpawnRadius, NavLocation))
+		{
+			Location = NavLocation.Location;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		const FRotator Rotation(0.f, FMath::FRandRange(0.f, 360.f), 0.f);
+		UClass* EnemyClass = LoadedClasses[FMath::RandRange(0, LoadedClasses.Num() - 1)];
+		APawn* Enemy = GetWorld()->SpawnActor<APawn>(EnemyClass, Location, Rotation, SpawnParams);
+		if (Enemy && Enemy->GetController() == nullptr)
+		{
+			Enemy->SpawnDefaultController();
+		}
+	}
+
+	//敌人在 BeginPlay 里已各自持有资源包
+	ReleaseEnemyClasses();
+}
+
+void AAuraEnemySpawner::ReleaseEnemyClasses()
+{
+	for (const ECharacterClass CharacterClass : AcquiredClasses)
+	{
+		UAuraAssetManager::Get().ReleaseCharacterClass(CharacterClass);
+	}
+	AcquiredClasses.Reset();
+	LoadHandles.Reset();
+}
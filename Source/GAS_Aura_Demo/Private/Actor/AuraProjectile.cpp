@@ -5,6 +5,7 @@
 
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
+#include "AuraStats.h"
 #include "NiagaraFunctionLibrary.h"
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
 #include "Components/AudioComponent.h"
@@ -13,6 +14,7 @@
 #include "GAS_Aura_Demo/GAS_Aura_Demo.h"
 #include "Interaction/EnemyInterface.h"
 #include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
 
 
 AAuraProjectile::AAuraProjectile()
@@ -35,13 +37,36 @@ AAuraProjectile::AAuraProjectile()
 	ProjectileMovementComponent->ProjectileGravityScale = 0.f;
 }
 
+void AAuraProjectile::SetTeam(EAuraTeam InTeam)
+{
+	Team = InTeam;
+	//敌我投射物走不同的对象通道，同阵营角色的网格体忽略该通道
+	Sphere->SetCollisionObjectType(UAuraAbilitySystemLibrary::GetProjectileChannelForTeam(Team));
+}
+
+void AAuraProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(AAuraProjectile, Team, COND_InitialOnly);
+}
+
 void AAuraProjectile::BeginPlay()
 {
 	Super::BeginPlay();
+	//客户端在 BeginPlay 前已收到初始复制的阵营
+	SetTeam(Team);
 	SetLifeSpan(LiveSpan);
 	Sphere->OnComponentBeginOverlap.AddDynamic(this, &AAuraProjectile::OnSphereOverlap);
 
 	LoopingSoundComponent = UGameplayStatics::SpawnSoundAttached(LoopingSound, GetRootComponent());
+	AuraStats::ProjectileSpawned();
+}
+
+void AAuraProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	AuraStats::ProjectileDestroyed();
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAuraProjectile::Destroyed()
@@ -63,6 +88,7 @@ void AAuraProjectile::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent,
                                       bool bFromSweep,
                                       const FHitResult& SweepResult)
 {
+	AURA_COMBAT_SCOPE(STAT_AuraProjectileOverlap, AuraProjectiles);
 	if (!DamageEffectSpecHandle.Data.IsValid()||
 		DamageEffectSpecHandle.Data.Get()->GetContext().GetEffectCauser()==OtherActor||
 		!UAuraAbilitySystemLibrary::IsNotFriend(DamageEffectSpecHandle.Data.Get()->GetContext().GetEffectCauser(),OtherActor))
@@ -1,71 +1,106 @@
 #include "AuraAbilityTypes.h"
 
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
+
+namespace AuraEffectContextRepBits
+{
+	enum : uint32
+	{
+		InstigatorBit = 1 << 0,
+		EffectCauserBit = 1 << 1,
+		AbilityCDOBit = 1 << 2,
+		SourceObjectBit = 1 << 3,
+		ActorsBit = 1 << 4,
+		HitResultBit = 1 << 5,
+		WorldOriginBit = 1 << 6,
+		BlockedHitBit = 1 << 7, //标志位本身就是值，不再额外序列化 bool
+		CriticalHitBit = 1 << 8,
+		HitResultLiteBit = 1 << 9, //命中结果只带 Location（投射物用来传目标点）
+	};
+	constexpr int32 NumBits = 10;
+}
+
+bool FAuraGameplayEffectContext::IsHitResultLite(const FHitResult& Hit)
+{
+	return !Hit.bBlockingHit && !Hit.bStartPenetrating
+		&& !Hit.HitObjectHandle.IsValid() && !Hit.Component.IsValid() && !Hit.PhysMaterial.IsValid()
+		&& Hit.ImpactPoint.IsZero() && Hit.ImpactNormal.IsZero() && Hit.Normal.IsZero()
+		&& Hit.TraceStart.IsZero() && Hit.TraceEnd.IsZero()
+		&& Hit.BoneName.IsNone() && Hit.FaceIndex == INDEX_NONE;
+}
+
 bool FAuraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
+	using namespace AuraEffectContextRepBits;
+
 	uint32 RepBits = 0;
 	if (Ar.IsSaving())
 	{
 		if (bReplicateInstigator && Instigator.IsValid())
 		{
-			RepBits |= 1 << 0;
+			RepBits |= InstigatorBit;
 		}
 		if (bReplicateEffectCauser && EffectCauser.IsValid())
 		{
-			RepBits |= 1 << 1;
+			RepBits |= EffectCauserBit;
 		}
 		if (AbilityCDO.IsValid())
 		{
-			RepBits |= 1 << 2;
+			RepBits |= AbilityCDOBit;
 		}
 		if (bReplicateSourceObject && SourceObject.IsValid())
 		{
-			RepBits |= 1 << 3;
+			RepBits |= SourceObjectBit;
 		}
 		if (Actors.Num() > 0)
 		{
-			RepBits |= 1 << 4;
+			RepBits |= ActorsBit;
 		}
 		if (HitResult.IsValid())
 		{
-			RepBits |= 1 << 5;
+			RepBits |= IsHitResultLite(*HitResult) ? HitResultLiteBit : HitResultBit;
 		}
 		if (bHasWorldOrigin)
 		{
-			RepBits |= 1 << 6;
+			RepBits |= WorldOriginBit;
 		}
 		if (bIsBlockedHit)
 		{
-			RepBits |= 1 << 7;
+			RepBits |= BlockedHitBit;
 		}
 		if (bIsCriticalHit)
 		{
-			RepBits |= 1 << 8;
+			RepBits |= CriticalHitBit;
 		}
 	}
 
-	Ar.SerializeBits(&RepBits, 9);
+	Ar.SerializeBits(&RepBits, NumBits);
 
-	if (RepBits & (1 << 0))
+	if (RepBits & InstigatorBit)
 	{
 		Ar << Instigator;
 	}
-	if (RepBits & (1 << 1))
+	if (RepBits & EffectCauserBit)
 	{
 		Ar << EffectCauser;
 	}
-	if (RepBits & (1 << 2))
+	if (RepBits & AbilityCDOBit)
 	{
 		Ar << AbilityCDO;
 	}
-	if (RepBits & (1 << 3))
+	if (RepBits & SourceObjectBit)
 	{
 		Ar << SourceObject;
 	}
-	if (RepBits & (1 << 4))
+	if (RepBits & ActorsBit)
 	{
 		SafeNetSerializeTArray_Default<31>(Ar, Actors);
 	}
-	if (RepBits & (1 << 5))
+	if (RepBits & (HitResultBit | HitResultLiteBit))
 	{
 		if (Ar.IsLoading())
 		{
@@ -74,31 +109,183 @@ bool FAuraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* M
 				HitResult = TSharedPtr<FHitResult>(new FHitResult());
 			}
 		}
-		HitResult->NetSerialize(Ar, Map, bOutSuccess);
+		if (RepBits & HitResultLiteBit)
+		{
+			FVector_NetQuantize10 Location(HitResult->Location);
+			Location.NetSerialize(Ar, Map, bOutSuccess);
+			if (Ar.IsLoading())
+			{
+				*HitResult = FHitResult();
+				HitResult->Location = Location;
+			}
+		}
+		else
+		{
+			HitResult->NetSerialize(Ar, Map, bOutSuccess);
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		HitResult.Reset();
 	}
-	if (RepBits & (1 << 6))
+	if (RepBits & WorldOriginBit)
 	{
-		Ar << WorldOrigin;
+		FVector_NetQuantize10 QuantizedOrigin(WorldOrigin);
+		QuantizedOrigin.NetSerialize(Ar, Map, bOutSuccess);
+		WorldOrigin = QuantizedOrigin;
 		bHasWorldOrigin = true;
 	}
 	else
 	{
 		bHasWorldOrigin = false;
 	}
-	if (RepBits & (1 << 7))
+
+	if (Ar.IsLoading())
+	{
+		bIsBlockedHit = (RepBits & BlockedHitBit) != 0;
+		bIsCriticalHit = (RepBits & CriticalHitBit) != 0;
+		AddInstigator(Instigator.Get(), EffectCauser.Get()); // Just to initialize InstigatorAbilitySystemComponent
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FAuraDamageNumber::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	UObject* TargetObject = Target;
+	if (Map)
 	{
-		Ar << bIsBlockedHit;
+		Map->SerializeObject(Ar, ACharacter::StaticClass(), TargetObject);
 	}
-	if (RepBits & (1 << 8))
+
+	uint32 QuantizedDamage = 0;
+	uint8 Flags = 0;
+	if (Ar.IsSaving())
 	{
-		Ar << bIsCriticalHit;
+		QuantizedDamage = FMath::RoundToInt(FMath::Max(Damage, 0.f) * 10.f);
+		Flags = (bIsBlockedHit ? 1 : 0) | (bIsCriticalHit ? 2 : 0);
 	}
-	
+	Ar.SerializeIntPacked(QuantizedDamage);
+	Ar.SerializeBits(&Flags, 2);
+
 	if (Ar.IsLoading())
 	{
-		AddInstigator(Instigator.Get(), EffectCauser.Get()); // Just to initialize InstigatorAbilitySystemComponent
+		Target = Cast<ACharacter>(TargetObject);
+		Damage = QuantizedDamage / 10.f;
+		bIsBlockedHit = (Flags & 1) != 0;
+		bIsCriticalHit = (Flags & 2) != 0;
 	}
 
-	bOutSuccess = true;
+	bOutSuccess = !Ar.IsError();
 	return true;
 }
+
+#if !UE_BUILD_SHIPPING
+namespace
+{
+	//改动前的格式：9 位标志 + 完整 FHitResult + 未量化的 WorldOrigin + 每个标志再写一个 bool
+	int64 MeasureBaselineBits(FAuraGameplayEffectContext& Context, UPackageMap* Map)
+	{
+		FNetBitWriter Writer(Map, 0);
+		uint32 RepBits = 0;
+		Writer.SerializeBits(&RepBits, 9);
+		bool bOutSuccess = true;
+		if (const FHitResult* SourceHit = Context.GetHitResult())
+		{
+			FHitResult Hit = *SourceHit;
+			Hit.NetSerialize(Writer, Map, bOutSuccess);
+		}
+		if (Context.HasOrigin())
+		{
+			FVector Origin = Context.GetOrigin();
+			Writer << Origin;
+		}
+		bool bBlocked = Context.GetIsBlockedHit();
+		bool bCritical = Context.GetIsCriticalHit();
+		if (bBlocked) Writer << bBlocked;
+		if (bCritical) Writer << bCritical;
+		return Writer.GetNumBits();
+	}
+
+	bool RoundTrip(const TCHAR* CaseName, FAuraGameplayEffectContext& Source, UPackageMap* Map)
+	{
+		FNetBitWriter Writer(Map, 0);
+		bool bOutSuccess = false;
+		Source.NetSerialize(Writer, Map, bOutSuccess);
+
+		FNetBitReader Reader(Map, Writer.GetData(), Writer.GetNumBits());
+		FAuraGameplayEffectContext Loaded;
+		Loaded.NetSerialize(Reader, Map, bOutSuccess);
+
+		bool bPassed = bOutSuccess && !Reader.IsError()
+			&& Loaded.GetIsBlockedHit() == Source.GetIsBlockedHit()
+			&& Loaded.GetIsCriticalHit() == Source.GetIsCriticalHit()
+			&& Loaded.HasOrigin() == Source.HasOrigin()
+			&& (Loaded.GetHitResult() != nullptr) == (Source.GetHitResult() != nullptr);
+		if (bPassed && Source.HasOrigin())
+		{
+			bPassed = Loaded.GetOrigin().Equals(Source.GetOrigin(), 0.1f);
+		}
+		if (bPassed && Source.GetHitResult())
+		{
+			bPassed = Loaded.GetHitResult()->Location.Equals(Source.GetHitResult()->Location, 0.1f);
+		}
+
+		const int64 BaselineBits = MeasureBaselineBits(Source, Map);
+		UE_LOG(LogTemp, Display, TEXT("EffectContext [%s] %s | compact %lld bits (%lld bytes) | baseline %lld bits (%lld bytes)"),
+		       CaseName, bPassed ? TEXT("PASS") : TEXT("FAIL"),
+		       Writer.GetNumBits(), Writer.GetNumBytes(), BaselineBits, (BaselineBits + 7) / 8);
+		return bPassed;
+	}
+}
+
+//用法：Aura.EffectContext.Test，联网会话中会额外测试带组件引用的完整命中结果
+static FAutoConsoleCommandWithWorld GAuraEffectContextTestCommand(
+	TEXT("Aura.EffectContext.Test"),
+	TEXT("Round-trips FAuraGameplayEffectContext through NetSerialize and logs compact vs baseline sizes."),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		UPackageMap* Map = nullptr;
+		if (const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr)
+		{
+			const UNetConnection* Connection = NetDriver->ServerConnection ? NetDriver->ServerConnection.Get()
+				: (NetDriver->ClientConnections.Num() > 0 ? NetDriver->ClientConnections[0].Get() : nullptr);
+			Map = Connection ? Connection->PackageMap : nullptr;
+		}
+
+		int32 NumFailed = 0;
+		const FVector TargetLocation(1234.56f, -789.01f, 42.f);
+
+		FAuraGameplayEffectContext Flags;
+		Flags.SetIsBlockedHit(true);
+		Flags.SetIsCriticalHit(true);
+		NumFailed += RoundTrip(TEXT("Flags"), Flags, Map) ? 0 : 1;
+
+		FAuraGameplayEffectContext ProjectileTarget;
+		FHitResult TargetHit;
+		TargetHit.Location = TargetLocation;
+		ProjectileTarget.AddHitResult(TargetHit);
+		ProjectileTarget.SetIsCriticalHit(true);
+		NumFailed += RoundTrip(TEXT("ProjectileTarget"), ProjectileTarget, Map) ? 0 : 1;
+
+		FAuraGameplayEffectContext Origin;
+		Origin.AddOrigin(TargetLocation);
+		NumFailed += RoundTrip(TEXT("Origin"), Origin, Map) ? 0 : 1;
+
+		//完整命中结果会序列化对象引用，需要联网会话中的 PackageMap
+		if (Map)
+		{
+			FAuraGameplayEffectContext FullHit;
+			FHitResult Hit(nullptr, nullptr, TargetLocation, FVector::UpVector);
+			Hit.bBlockingHit = true;
+			Hit.ImpactPoint = TargetLocation;
+			FullHit.AddHitResult(Hit);
+			FullHit.AddOrigin(TargetLocation);
+			FullHit.SetIsBlockedHit(true);
+			NumFailed += RoundTrip(TEXT("FullHit"), FullHit, Map) ? 0 : 1;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("EffectContext round-trip: %s"), NumFailed == 0 ? TEXT("all passed") : TEXT("FAILED"));
+	}));
+#endif
@@ -5,6 +5,12 @@
 
 #include "AbilitySystemGlobals.h"
 #include "AuraGameplayTags.h"
+#include "AbilitySystem/Data/AttributeFormulaInfo.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+
+const FPrimaryAssetType UAuraAssetManager::CharacterClassAssetType(TEXT("AuraCharacterClass"));
+const FName UAuraAssetManager::CharacterClassBundleName(TEXT("Game"));
 
 UAuraAssetManager& UAuraAssetManager::Get()
 {
@@ -13,6 +19,12 @@ UAuraAssetManager& UAuraAssetManager::Get()
 	return *AuraAssetManager;
 }
 
+FPrimaryAssetId UAuraAssetManager::GetCharacterClassAssetId(ECharacterClass CharacterClass)
+{
+	const FString ClassName = StaticEnum<ECharacterClass>()->GetNameStringByValue(static_cast<int64>(CharacterClass));
+	return FPrimaryAssetId(CharacterClassAssetType, FName(*ClassName));
+}
+
 void UAuraAssetManager::StartInitialLoading()
 {
 	Super::StartInitialLoading();
@@ -20,4 +32,163 @@ void UAuraAssetManager::StartInitialLoading()
 
 	//加上这句才能使用TargetData！！！
 	UAbilitySystemGlobals::Get().InitGlobalData();
+
+	if (!AttributeFormulaInfoAsset.IsNull())
+	{
+		AttributeFormulaInfo = AttributeFormulaInfoAsset.LoadSynchronous();
+		UE_CLOG(AttributeFormulaInfo == nullptr, LogTemp, Error, TEXT("Failed to load AttributeFormulaInfo %s"), *AttributeFormulaInfoAsset.ToString());
+	}
+}
+
+const UAttributeFormulaInfo& UAuraAssetManager::GetAttributeFormulaInfo()
+{
+	const UAuraAssetManager* AuraAssetManager = GEngine ? Cast<UAuraAssetManager>(GEngine->AssetManager) : nullptr;
+	if (AuraAssetManager && AuraAssetManager->AttributeFormulaInfo)
+	{
+		return *AuraAssetManager->AttributeFormulaInfo;
+	}
+	return *GetDefault<UAttributeFormulaInfo>();
+}
+
+void UAuraAssetManager::PostInitialAssetScan()
+{
+	Super::PostInitialAssetScan();
+
+	//职业资源包没有对应的资产文件，以动态主资产的形式只登记包内容
+	for (const FAuraCharacterClassBundle& Bundle : CharacterClassBundles)
+	{
+		FAssetBundleData BundleData;
+		for (const TSoftClassPtr<APawn>& EnemyClass : Bundle.EnemyClasses)
+		{
+			BundleData.AddBundleAsset(CharacterClassBundleName, EnemyClass.ToSoftObjectPath().GetAssetPath());
+		}
+		AddDynamicAsset(GetCharacterClassAssetId(Bundle.CharacterClass), FSoftObjectPath(), BundleData);
+		BundleStates.FindOrAdd(Bundle.CharacterClass).NumAssets += Bundle.EnemyClasses.Num();
+	}
+}
+
+TSharedPtr<FStreamableHandle> UAuraAssetManager::AcquireCharacterClass(ECharacterClass CharacterClass, FStreamableDelegate OnLoaded)
+{
+	FCharacterClassBundleState& State = BundleStates.FindOrAdd(CharacterClass);
+	const FPrimaryAssetId AssetId = GetCharacterClassAssetId(CharacterClass);
+	TSharedPtr<FStreamableHandle> Handle;
+	if (State.RefCount++ == 0)
+	{
+		State.RequestTime = FPlatformTime::Seconds();
+		State.LoadMs = -1.0;
+		++NumBundleLoads;
+		Handle = LoadPrimaryAsset(AssetId, {CharacterClassBundleName},
+			FStreamableDelegate::CreateUObject(this, &UAuraAssetManager::OnCharacterClassLoaded, CharacterClass));
+	}
+	else
+	{
+		//每个敌人都会 Acquire，已请求过的直接复用句柄，不再走一遍资源包状态变更
+		Handle = GetPrimaryAssetHandle(AssetId);
+	}
+	if (OnLoaded.IsBound())
+	{
+		if (!Handle.IsValid() || Handle->HasLoadCompleted())
+		{
+			OnLoaded.Execute();
+		}
+		else
+		{
+			Handle->BindCompleteDelegate(OnLoaded);
+		}
+	}
+	return Handle;
 }
+
+TSharedPtr<FStreamableHandle> UAuraAssetManager::RequestEnemyClass(const FSoftObjectPath& EnemyClassPath,
+                                                                  TOptional<ECharacterClass>& OutAcquiredClass,
+                                                                  FStreamableDelegate OnLoaded)
+{
+	OutAcquiredClass.Reset();
+	for (const FAuraCharacterClassBundle& Bundle : CharacterClassBundles)
+	{
+		const bool bInBundle = Bundle.EnemyClasses.ContainsByPredicate([&EnemyClassPath](const TSoftClassPtr<APawn>& EnemyClass)
+		{
+			return EnemyClass.ToSoftObjectPath() == EnemyClassPath;
+		});
+		if (bInBundle)
+		{
+			OutAcquiredClass = Bundle.CharacterClass;
+			return AcquireCharacterClass(Bundle.CharacterClass, MoveTemp(OnLoaded));
+		}
+	}
+
+	//未登记到职业资源包的类只加载它自己；路径为空时不会发请求，回调也照常执行，调用方不用区分
+	TSharedPtr<FStreamableHandle> Handle = GetStreamableManager().RequestAsyncLoad(EnemyClassPath, OnLoaded);
+	if (!Handle.IsValid() && OnLoaded.IsBound())
+	{
+		OnLoaded.Execute();
+	}
+	return Handle;
+}
+
+void UAuraAssetManager::ReleaseCharacterClass(ECharacterClass CharacterClass)
+{
+	FCharacterClassBundleState* State = BundleStates.Find(CharacterClass);
+	if (State == nullptr || State->RefCount <= 0) return;
+
+	if (--State->RefCount == 0)
+	{
+		UnloadPrimaryAsset(GetCharacterClassAssetId(CharacterClass));
+		State->LoadMs = -1.0;
+		++NumBundleUnloads;
+	}
+}
+
+bool UAuraAssetManager::IsCharacterClassLoaded(ECharacterClass CharacterClass) const
+{
+	const TSharedPtr<FStreamableHandle> Handle = GetPrimaryAssetHandle(GetCharacterClassAssetId(CharacterClass));
+	return Handle.IsValid() && Handle->HasLoadCompleted();
+}
+
+bool UAuraAssetManager::IsCharacterClassLoading(ECharacterClass CharacterClass) const
+{
+	const TSharedPtr<FStreamableHandle> Handle = GetPrimaryAssetHandle(GetCharacterClassAssetId(CharacterClass));
+	return Handle.IsValid() && Handle->IsLoadingInProgress();
+}
+
+void UAuraAssetManager::PreloadCharacterClass(ECharacterClass CharacterClass)
+{
+	Get().AcquireCharacterClass(CharacterClass);
+}
+
+void UAuraAssetManager::ReleasePreloadedCharacterClass(ECharacterClass CharacterClass)
+{
+	Get().ReleaseCharacterClass(CharacterClass);
+}
+
+void UAuraAssetManager::OnCharacterClassLoaded(ECharacterClass CharacterClass)
+{
+	FCharacterClassBundleState* State = BundleStates.Find(CharacterClass);
+	if (State == nullptr || State->RefCount <= 0 || State->LoadMs >= 0.0) return;
+
+	State->LoadMs = (FPlatformTime::Seconds() - State->RequestTime) * 1000.0;
+	UE_LOG(LogTemp, Log, TEXT("Character class bundle %s loaded: %d assets in %.1f ms"),
+	       *GetCharacterClassAssetId(CharacterClass).ToString(), State->NumAssets, State->LoadMs);
+}
+
+void UAuraAssetManager::LogCharacterClassBundles() const
+{
+	for (const TPair<ECharacterClass, FCharacterClassBundleState>& Pair : BundleStates)
+	{
+		const FCharacterClassBundleState& State = Pair.Value;
+		const TCHAR* Status = IsCharacterClassLoaded(Pair.Key) ? TEXT("Loaded") : State.RefCount > 0 ? TEXT("Loading") : TEXT("Unloaded");
+		UE_LOG(LogTemp, Display, TEXT("%-36s %-8s refs %d, %d assets, load %.1f ms"),
+		       *GetCharacterClassAssetId(Pair.Key).ToString(), Status, State.RefCount, State.NumAssets, State.LoadMs);
+	}
+	UE_LOG(LogTemp, Display, TEXT("Character class bundles: %d loads, %d unloads"), NumBundleLoads, NumBundleUnloads);
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand GAuraClassBundlesCommand(
+	TEXT("Aura.Assets.ClassBundles"),
+	TEXT("List character class bundles with load state, reference count and async load time"),
+	FConsoleCommandDelegate::CreateStatic([]()
+	{
+		UAuraAssetManager::Get().LogCharacterClassBundles();
+	}));
+#endif
@@ -4,109 +4,57 @@
 #include "AuraGameplayTags.h"
 
 #include "GameplayTagsManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 FAuraGameplayTags FAuraGameplayTags::GameplayTags;
 
 void FAuraGameplayTags::InitializeNativeGameplayTags()
 {
-	//~ 主要属性
-	GameplayTags.Attributes_Primary_Strength = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Primary.Strength"), FString(TEXT("增加物理伤害")));
-	GameplayTags.Attributes_Primary_Intelligence = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Primary.Intelligence"), FString(TEXT("增加魔法伤害和最大法力值")));
-	GameplayTags.Attributes_Primary_Resilience = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Primary.Resilience"), FString(TEXT("增加护甲与护甲穿透")));
-	GameplayTags.Attributes_Primary_Vigor = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Primary.Vigor"), FString(TEXT("增加最大生命值")));
-
-	//~ 次要属性
-	GameplayTags.Attributes_Secondary_Armor = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.Armor"), FString(TEXT("减少受到的伤害，增加格挡概率")));
-	GameplayTags.Attributes_Secondary_ArmorPenetration = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.ArmorPenetration"), FString(TEXT("忽视敌人护甲，增加暴击概率")));
-	GameplayTags.Attributes_Secondary_BlockChance = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.BlockChance"), FString(TEXT("受到伤害减半（格挡）的概率")));
-	GameplayTags.Attributes_Secondary_CriticalHitChance = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.CriticalHitChance"), FString(TEXT("造成额外伤害（暴击）的概率")));
-	GameplayTags.Attributes_Secondary_CriticalHitDamage = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.CriticalHitDamage"), FString(TEXT("暴击时增加的额外伤害")));
-	GameplayTags.Attributes_Secondary_CriticalHitResistance = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.CriticalHitResistance"), FString(TEXT("减少敌人暴击的概率")));
-	GameplayTags.Attributes_Secondary_HealthRegeneration = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.HealthRegeneration"), FString(TEXT("每秒生命回复")));
-	GameplayTags.Attributes_Secondary_ManaRegeneration = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.ManaRegeneration"), FString(TEXT("每秒法力回复")));
-	GameplayTags.Attributes_Secondary_MaxHealth = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.MaxHealth"), FString(TEXT("可获得的生命值上限")));
-	GameplayTags.Attributes_Secondary_MaxMana = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Secondary.MaxMana"), FString(TEXT("可获得的最大法力值上限")));
-	
-	//~ 抗性（次级属性）
-	GameplayTags.Attributes_Resistance_Fire = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Resistance.Fire"), FString(TEXT("火焰抗性")));
-	GameplayTags.Attributes_Resistance_Lighting = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Resistance.Lighting"), FString(TEXT("雷电抗性")));
-	GameplayTags.Attributes_Resistance_Arcane = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Resistance.Arcane"), FString(TEXT("奥术抗性")));
-	GameplayTags.Attributes_Resistance_Physical = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Attributes.Resistance.Physical"), FString(TEXT("物理抗性")));
-	
-	//~ 伤害类型
-	GameplayTags.Damage = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Damage"), FString(TEXT("造成伤害")));
-	GameplayTags.Damage_Fire = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Damage.Fire"), FString(TEXT("火焰伤害类型")));
-	GameplayTags.Damage_Lighting = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Damage.Lighting"), FString(TEXT("雷电伤害类型")));
-	GameplayTags.Damage_Arcane = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Damage.Arcane"), FString(TEXT("奥术伤害类型")));
-	GameplayTags.Damage_Physical = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Damage.Physical"), FString(TEXT("物理伤害类型")));
-		//伤害类型到抗性的映射表
-	GameplayTags.DamageTypesToResistances.Add(GameplayTags.Damage_Fire,GameplayTags.Attributes_Resistance_Fire);
-	GameplayTags.DamageTypesToResistances.Add(GameplayTags.Damage_Lighting,GameplayTags.Attributes_Resistance_Lighting);
-	GameplayTags.DamageTypesToResistances.Add(GameplayTags.Damage_Arcane,GameplayTags.Attributes_Resistance_Arcane);
-	GameplayTags.DamageTypesToResistances.Add(GameplayTags.Damage_Physical,GameplayTags.Attributes_Resistance_Physical);
-	
-	//~ Input Tags
-	GameplayTags.InputTag_LMB = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("InputTag.LMB"), FString(TEXT("鼠标左键的输入标签")));
-	GameplayTags.InputTag_RMB = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("InputTag.RMB"), FString(TEXT("鼠标右键的输入标签")));
-	GameplayTags.InputTag_1 = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("InputTag.1"), FString(TEXT("键盘 1 键的输入标签")));
-	GameplayTags.InputTag_2 = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("InputTag.2"), FString(TEXT("键盘 2 键的输入标签")));
-	GameplayTags.InputTag_3 = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("InputTag.3"), FString(TEXT("键盘 3 键的输入标签")));
-	GameplayTags.InputTag_4 = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("InputTag.4"), FString(TEXT("键盘 4 键的输入标签")));
-	
-	//~ Effects
-	GameplayTags.Effects_HitReact = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Effects.HitReact"), FString(TEXT("受击反应时赋予标签")));
-
-	//~ 角色能力
-	GameplayTags.Abilities_Attack = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Abilities.Attack"), FString(TEXT("近战敌人的近战攻击")));
+	TRACE_CPUPROFILER_EVENT_SCOPE(FAuraGameplayTags::InitializeNativeGameplayTags);
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+
+	//注册本身仍需按字符串交给 TagsManager，注册与建下标表两段分别计时
+	const double RegisterStart = FPlatformTime::Seconds();
+#define AURA_REGISTER_NATIVE_TAG(Member, TagName, Comment) \
+	GameplayTags.Member = TagsManager.AddNativeGameplayTag(FName(TagName), FString(TEXT(Comment)));
+	AURA_NATIVE_GAMEPLAY_TAGS(AURA_REGISTER_NATIVE_TAG)
+#undef AURA_REGISTER_NATIVE_TAG
+
+	const double IndexStart = FPlatformTime::Seconds();
+	GameplayTags.IndexTable = TStaticArray<FIndexSlot, IndexTableSize>();
+#define AURA_INDEX_NATIVE_TAG(Member, TagName, Comment) \
+	GameplayTags.AddToIndex(EAuraNativeTag::Member, GameplayTags.Member);
+	AURA_NATIVE_GAMEPLAY_TAGS(AURA_INDEX_NATIVE_TAG)
+#undef AURA_INDEX_NATIVE_TAG
+	const double EndTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogTemp, Log, TEXT("Registered %d native gameplay tags in %.3f ms, index built in %.3f ms"),
+	       static_cast<int32>(EAuraNativeTag::Count), (IndexStart - RegisterStart) * 1000.0, (EndTime - IndexStart) * 1000.0);
+}
 
-	//~ 战斗插槽 
-	GameplayTags.CombatSocket_Weapon = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("CombatSocket.Weapon"), FString(TEXT("武器战斗插槽")));
-	GameplayTags.CombatSocket_LeftHand = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("CombatSocket.LeftHand"), FString(TEXT("左手战斗插槽")));
-	GameplayTags.CombatSocket_RightHand = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("CombatSocket.RightHand"), FString(TEXT("右手战斗插槽")));
-	GameplayTags.CombatSocket_Tail = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("CombatSocket.Tail"), FString(TEXT("尾巴战斗插槽")));
+EAuraNativeTag FAuraGameplayTags::IndexOf(const FGameplayTag& Tag) const
+{
+	const FName TagName = Tag.GetTagName();
+	if (TagName.IsNone()) return EAuraNativeTag::None;
+
+	for (uint32 Slot = GetTypeHash(TagName) & (IndexTableSize - 1);; Slot = (Slot + 1) & (IndexTableSize - 1))
+	{
+		const FIndexSlot& IndexSlot = IndexTable[Slot];
+		if (IndexSlot.Index == EAuraNativeTag::None) return EAuraNativeTag::None;
+		if (IndexSlot.TagName == TagName) return IndexSlot.Index;
+	}
+}
 
-	//~ 蒙太奇攻击动画 
-	GameplayTags.Montage_Attack_1 = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Montage.Attack.1"), FString(TEXT("蒙太奇攻击动画 1")));
-	GameplayTags.Montage_Attack_2 = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Montage.Attack.2"), FString(TEXT("蒙太奇攻击动画 2")));
-	GameplayTags.Montage_Attack_3 = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Montage.Attack.3"), FString(TEXT("蒙太奇攻击动画 3")));
-	GameplayTags.Montage_Attack_4 = UGameplayTagsManager::Get().AddNativeGameplayTag(
-		FName("Montage.Attack.4"), FString(TEXT("蒙太奇攻击动画 4")));
+void FAuraGameplayTags::AddToIndex(EAuraNativeTag Index, const FGameplayTag& Tag)
+{
+	TagsByIndex[static_cast<uint8>(Index)] = Tag;
+
+	//线性探测，表长至少为标签数的两倍，不会填满
+	uint32 Slot = GetTypeHash(Tag.GetTagName()) & (IndexTableSize - 1);
+	while (IndexTable[Slot].Index != EAuraNativeTag::None)
+	{
+		Slot = (Slot + 1) & (IndexTableSize - 1);
+	}
+	IndexTable[Slot].TagName = Tag.GetTagName();
+	IndexTable[Slot].Index = Index;
 }
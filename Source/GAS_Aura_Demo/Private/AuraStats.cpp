@@ -0,0 +1,97 @@
+// Copyright Liupingan
+
+
+#include "AuraStats.h"
+
+#include "ProfilingDebugging/CountersTrace.h"
+
+DEFINE_STAT(STAT_AuraExecCalcDamage);
+DEFINE_STAT(STAT_AuraMMCAttributeFormula);
+DEFINE_STAT(STAT_AuraDerivedAttributesFlush);
+DEFINE_STAT(STAT_AuraPostGameplayEffectExecute);
+DEFINE_STAT(STAT_AuraSpawnProjectile);
+DEFINE_STAT(STAT_AuraProjectileOverlap);
+DEFINE_STAT(STAT_AuraAreaEffectPulse);
+DEFINE_STAT(STAT_AuraCursorTrace);
+DEFINE_STAT(STAT_AuraAutoRun);
+DEFINE_STAT(STAT_AuraWidgetControllerBroadcast);
+DEFINE_STAT(STAT_AuraShowDamageNumbers);
+DEFINE_STAT(STAT_AuraFlushDamageNumbers);
+DEFINE_STAT(STAT_AuraBehaviorTreeTick);
+DEFINE_STAT(STAT_AuraAILODEvaluate);
+
+DEFINE_STAT(STAT_AuraEffectsApplied);
+DEFINE_STAT(STAT_AuraProjectilesAlive);
+DEFINE_STAT(STAT_AuraDamageNumbersSpawned);
+DEFINE_STAT(STAT_AuraDerivedAttributesRecomputed);
+
+UE_TRACE_CHANNEL_DEFINE(AuraCombatChannel);
+
+CSV_DEFINE_CATEGORY_MODULE(GAS_AURA_DEMO_API, AuraCombat, true);
+
+LLM_DEFINE_TAG(Aura);
+LLM_DEFINE_TAG(Aura_Enemies);
+LLM_DEFINE_TAG(Aura_Players);
+LLM_DEFINE_TAG(Aura_AbilitySystem);
+LLM_DEFINE_TAG(Aura_AI);
+LLM_DEFINE_TAG(Aura_UI);
+LLM_DEFINE_TAG(Aura_Projectiles);
+LLM_DEFINE_TAG(Aura_Subsystems);
+
+//Insights 计数器：效果与伤害数字记录累计值，投射物记录当前存活数
+TRACE_DECLARE_INT_COUNTER(AuraEffectsAppliedTotal, TEXT("AuraCombat/EffectsApplied"));
+TRACE_DECLARE_INT_COUNTER(AuraProjectilesAlive, TEXT("AuraCombat/ProjectilesAlive"));
+TRACE_DECLARE_INT_COUNTER(AuraDamageNumbersTotal, TEXT("AuraCombat/DamageNumbersSpawned"));
+TRACE_DECLARE_INT_COUNTER(AuraDerivedAttributesTotal, TEXT("AuraCombat/DerivedAttributesRecomputed"));
+
+namespace AuraStats
+{
+	static int32 GNumProjectilesAlive = 0;
+	static int32 GNumProjectilesSpawned = 0;
+
+	void EffectApplied()
+	{
+		INC_DWORD_STAT(STAT_AuraEffectsApplied);
+		TRACE_COUNTER_INCREMENT(AuraEffectsAppliedTotal);
+		CSV_CUSTOM_STAT(AuraCombat, EffectsApplied, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	void ProjectileSpawned()
+	{
+		++GNumProjectilesAlive;
+		++GNumProjectilesSpawned;
+		INC_DWORD_STAT(STAT_AuraProjectilesAlive);
+		TRACE_COUNTER_INCREMENT(AuraProjectilesAlive);
+	}
+
+	void ProjectileDestroyed()
+	{
+		--GNumProjectilesAlive;
+		DEC_DWORD_STAT(STAT_AuraProjectilesAlive);
+		TRACE_COUNTER_DECREMENT(AuraProjectilesAlive);
+	}
+
+	void DamageNumberSpawned()
+	{
+		INC_DWORD_STAT(STAT_AuraDamageNumbersSpawned);
+		TRACE_COUNTER_INCREMENT(AuraDamageNumbersTotal);
+		CSV_CUSTOM_STAT(AuraCombat, DamageNumbersSpawned, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	void DerivedAttributesRecomputed(int32 NumAttributes)
+	{
+		INC_DWORD_STAT_BY(STAT_AuraDerivedAttributesRecomputed, NumAttributes);
+		TRACE_COUNTER_ADD(AuraDerivedAttributesTotal, NumAttributes);
+		CSV_CUSTOM_STAT(AuraCombat, DerivedAttributesRecomputed, NumAttributes, ECsvCustomStatOp::Accumulate);
+	}
+
+	int32 GetNumProjectilesAlive()
+	{
+		return GNumProjectilesAlive;
+	}
+
+	int32 GetNumProjectilesSpawned()
+	{
+		return GNumProjectilesSpawned;
+	}
+}
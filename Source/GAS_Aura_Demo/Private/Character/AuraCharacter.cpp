@@ -4,6 +4,7 @@
 #include "Character/AuraCharacter.h"
 
 #include "AbilitySystemComponent.h"
+#include "AuraStats.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Player/AuraPlayerController.h"
@@ -21,10 +22,12 @@ AAuraCharacter::AAuraCharacter()
 	bUseControllerRotationYaw=false;
 	bUseControllerRotationRoll=false;
 
+	Team = EAuraTeam::Player;
 }
 
 void AAuraCharacter::PossessedBy(AController* NewController)
 {
+	LLM_SCOPE_BYTAG(Aura_Players);
 	Super::PossessedBy(NewController);
 
 	// Init Ability Actor Info for the Server
@@ -52,6 +55,7 @@ int32 AAuraCharacter::GetPlayerLevel()
 
 void AAuraCharacter::InitAbilityActorInfo()
 {
+	LLM_SCOPE_BYTAG(Aura_Players);
 	AAuraPlayerState* AuraPlayerState=GetPlayerState<AAuraPlayerState>();
 	check(AuraPlayerState);
 	AbilitySystemComponent=AuraPlayerState->GetAbilitySystemComponent();
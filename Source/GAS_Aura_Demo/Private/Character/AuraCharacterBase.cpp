@@ -5,9 +5,15 @@
 
 #include "AuraGameplayTags.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AbilitySystem/AuraAttributeSet.h"
 #include "Components/CapsuleComponent.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "Game/AuraCombatantSubsystem.h"
+#include "GameFramework/GameStateBase.h"
 #include "GAS_Aura_Demo/GAS_Aura_Demo.h"
 #include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 
 //class UAuraAbilitySystemComponent;
@@ -23,6 +29,7 @@ AAuraCharacterBase::AAuraCharacterBase()
 	GetMesh()->SetGenerateOverlapEvents(true);
 	GetMesh()->SetCollisionResponseToChannel(ECC_Camera, ECR_Ignore);
 	GetMesh()->SetCollisionResponseToChannel(ECC_Projectile, ECR_Overlap);
+	GetMesh()->SetCollisionResponseToChannel(ECC_EnemyProjectile, ECR_Overlap);
 
 	Weapon = CreateDefaultSubobject<USkeletalMeshComponent>("Weapon");
 	Weapon->SetupAttachment(GetMesh(), FName("WeaponHandSocket"));
@@ -41,17 +48,63 @@ UAnimMontage* AAuraCharacterBase::GetHitReactMontage_Implementation()
 	return HitReactMontage;
 }
 
+void AAuraCharacterBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraCharacterBase, bDead, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraCharacterBase, DeathTime, Params);
+}
+
 //仅服务器上调用
 void AAuraCharacterBase::Die()
 {
-	Weapon->DetachFromComponent(FDetachmentTransformRules(EDetachmentRule::KeepWorld, true));
-	MulticastHandleDeath();
+	if (bDead) return;
+
+	bDead = true;
+	DeathTime = GetWorld()->GetTimeSeconds();
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraCharacterBase, bDead, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraCharacterBase, DeathTime, this);
+	HandleDeath();
+}
+
+void AAuraCharacterBase::ResetDeathState()
+{
+	if (!bDead) return;
+
+	bDead = false;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraCharacterBase, bDead, this);
+	HandleDeathStateReset();
+}
+
+void AAuraCharacterBase::OnRep_Dead()
+{
+	if (bDead)
+	{
+		HandleDeath();
+	}
+	else
+	{
+		HandleDeathStateReset();
+	}
 }
 
 //服务器和客户端都调用
-void AAuraCharacterBase::MulticastHandleDeath_Implementation()
+void AAuraCharacterBase::HandleDeath()
 {
-	UGameplayStatics::PlaySoundAtLocation(this,DeathSound,GetActorLocation());
+	if (bDeathHandled) return;
+	bDeathHandled = true;
+
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const float Now = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	if (Now - DeathTime <= DeathSoundMaxDelay)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this,DeathSound,GetActorLocation());
+	}
+
+	Weapon->DetachFromComponent(FDetachmentTransformRules(EDetachmentRule::KeepWorld, true));
 	Weapon->SetSimulatePhysics(true);
 	Weapon->SetEnableGravity(true);
 	Weapon->SetCollisionEnabled(ECollisionEnabled::Type::PhysicsOnly);
@@ -63,34 +116,85 @@ void AAuraCharacterBase::MulticastHandleDeath_Implementation()
 
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::Type::NoCollision);
 	Dissolve();
-	bDead = true;
+	if (UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(this))
+	{
+		CombatantSubsystem->SetCombatantDead(this, true);
+	}
 }
 
-void AAuraCharacterBase::BeginPlay()
+//对象池复用：撤销死亡时的布娃娃、溶解和碰撞设置，服务器和客户端都调用
+void AAuraCharacterBase::HandleDeathStateReset()
 {
-	Super::BeginPlay();
+	if (!bDeathHandled) return;
+	bDeathHandled = false;
+
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetEnableGravity(bDefaultMeshEnableGravity);
+	GetMesh()->SetCollisionEnabled(ECollisionEnabled::Type::QueryOnly);
+	GetMesh()->SetCollisionResponseToChannel(ECC_WorldStatic, DefaultMeshWorldStaticResponse);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	GetMesh()->SetRelativeTransform(DefaultMeshRelativeTransform);
+	GetMesh()->SetMaterial(0, DefaultMeshMaterial);
+
+	Weapon->SetSimulatePhysics(false);
+	Weapon->SetEnableGravity(bDefaultWeaponEnableGravity);
+	Weapon->SetCollisionEnabled(ECollisionEnabled::Type::NoCollision);
+	Weapon->AttachToComponent(GetMesh(), FAttachmentTransformRules::KeepRelativeTransform, FName("WeaponHandSocket"));
+	Weapon->SetRelativeTransform(DefaultWeaponRelativeTransform);
+	Weapon->SetMaterial(0, DefaultWeaponMaterial);
+
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::Type::QueryAndPhysics);
+	if (UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(this))
+	{
+		CombatantSubsystem->SetCombatantDead(this, false);
+	}
 }
 
-FVector AAuraCharacterBase::GetCombatSocketLocation_Implementation(const FGameplayTag& SocketTag)
+void AAuraCharacterBase::BeginPlay()
 {
-	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
-	if (SocketTag == GameplayTags.CombatSocket_Weapon && IsValid(Weapon))
+	Super::BeginPlay();
+	DefaultMeshRelativeTransform = GetMesh()->GetRelativeTransform();
+	DefaultWeaponRelativeTransform = Weapon->GetRelativeTransform();
+	DefaultMeshWorldStaticResponse = GetMesh()->GetCollisionResponseToChannel(ECC_WorldStatic);
+	bDefaultMeshEnableGravity = GetMesh()->IsGravityEnabled();
+	bDefaultWeaponEnableGravity = Weapon->IsGravityEnabled();
+	DefaultMeshMaterial = GetMesh()->GetMaterial(0);
+	DefaultWeaponMaterial = Weapon->GetMaterial(0);
+	//本阵营的投射物在碰撞层面就不产生重叠，不再进入 OnSphereOverlap
+	if (Team != EAuraTeam::Neutral)
 	{
-		return Weapon->GetSocketLocation(WeaponTipSocketName);
+		GetMesh()->SetCollisionResponseToChannel(UAuraAbilitySystemLibrary::GetProjectileChannelForTeam(Team), ECR_Ignore);
 	}
-	if (SocketTag == GameplayTags.CombatSocket_LeftHand )
+	if (UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(this))
 	{
-		return GetMesh()->GetSocketLocation(LeftHandSocketName);
+		CombatantSubsystem->RegisterCombatant(this);
 	}
-	if (SocketTag == GameplayTags.CombatSocket_RightHand)
+}
+
+void AAuraCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(this))
 	{
-		return GetMesh()->GetSocketLocation(RightHandSocketName);
+		CombatantSubsystem->UnregisterCombatant(this);
 	}
-	if (SocketTag == GameplayTags.CombatSocket_Tail)
+	Super::EndPlay(EndPlayReason);
+}
+
+FVector AAuraCharacterBase::GetCombatSocketLocation_Implementation(const FGameplayTag& SocketTag)
+{
+	switch (FAuraGameplayTags::Get().IndexOf(SocketTag))
 	{
+	case EAuraNativeTag::CombatSocket_Weapon:
+		return IsValid(Weapon) ? Weapon->GetSocketLocation(WeaponTipSocketName) : FVector();
+	case EAuraNativeTag::CombatSocket_LeftHand:
+		return GetMesh()->GetSocketLocation(LeftHandSocketName);
+	case EAuraNativeTag::CombatSocket_RightHand:
+		return GetMesh()->GetSocketLocation(RightHandSocketName);
+	case EAuraNativeTag::CombatSocket_Tail:
 		return GetMesh()->GetSocketLocation(TailSocketName);
+	default:
+		return FVector();
 	}
-	return FVector();
 }
 
 bool AAuraCharacterBase::IsDie_Implementation() const
@@ -142,6 +246,11 @@ void AAuraCharacterBase::InitializeDefaultAttributes() const
 {
 	ApplyEffectToSelf(DefaultPrimaryAttributesEffectClass, 1.f);
 	ApplyEffectToSelf(DefaultSecondaryAttributesEffectClass, 1.f);
+	//生命/法力初始值读取 MaxHealth/MaxMana，先把全部派生属性算好
+	if (UAuraAttributeSet* AuraAttributeSet = Cast<UAuraAttributeSet>(AttributeSet))
+	{
+		AuraAttributeSet->RecomputeAllDerivedAttributes();
+	}
 	ApplyEffectToSelf(DefaultVitalAttributesEffectClass, 1.f);
 }
 
@@ -3,20 +3,26 @@
 
 #include "Character/AuraEnemy.h"
 
+#include "AuraAssetManager.h"
 #include "AuraGameplayTags.h"
+#include "AuraStats.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
 #include "AbilitySystem/AuraAttributeSet.h"
 #include "AI/AuraAIController.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BrainComponent.h"
 #include "Components/WidgetComponent.h"
+#include "Game/AuraSummonSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GAS_Aura_Demo/GAS_Aura_Demo.h"
+#include "Net/AuraReplicationGraph.h"
 #include "UI/Widget/AuraUserWidget.h"
 
 AAuraEnemy::AAuraEnemy()
 {
+	LLM_SCOPE_BYTAG(Aura_Enemies);
 	GetMesh()->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
 
 	AbilitySystemComponent = CreateDefaultSubobject<UAuraAbilitySystemComponent>("AbilitySystemComponent");
@@ -32,10 +38,13 @@ AAuraEnemy::AAuraEnemy()
 
 	HealthBar = CreateDefaultSubobject<UWidgetComponent>("HealthBar");
 	HealthBar->SetupAttachment(GetRootComponent());
+
+	Team = EAuraTeam::Enemy;
 }
 
 void AAuraEnemy::PossessedBy(AController* NewController)
 {
+	LLM_SCOPE_BYTAG(Aura_AI);
 	Super::PossessedBy(NewController);
 
 	if (!HasAuthority()) return;
@@ -77,19 +86,94 @@ int32 AAuraEnemy::GetPlayerLevel()
 
 void AAuraEnemy::Die()
 {
-	SetLifeSpan(LifeSpan);
+	if (bDead) return;
+
+	if (bPooledMinion)
+	{
+		GetWorldTimerManager().SetTimer(PoolReleaseTimer, this, &AAuraEnemy::ReleaseToPool, LifeSpan, false);
+	}
+	else
+	{
+		SetLifeSpan(LifeSpan);
+	}
 	if (AuraAIController){
 		AuraAIController->GetBlackboardComponent()->SetValueAsBool(FName("Dead"),true);
 	}
 	Super::Die();
 }
 
+void AAuraEnemy::ReleaseToPool()
+{
+	if (UAuraSummonSubsystem* SummonSubsystem = UAuraSummonSubsystem::Get(this))
+	{
+		SummonSubsystem->ReleaseMinion(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void AAuraEnemy::DeactivateForPool()
+{
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+	CombatTarget = nullptr;
+	if (AuraAIController && AuraAIController->GetBrainComponent())
+	{
+		AuraAIController->GetBrainComponent()->StopLogic(TEXT("Pooled"));
+	}
+}
+
+void AAuraEnemy::ReactivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	ResetDeathState();
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	bHitReacting = false;
+	GetCharacterMovement()->MaxWalkSpeed = BaseWalkSpeed;
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	//死亡期间档位变化只记录未应用，这里补上
+	if (const UAuraSignificanceSubsystem* SignificanceSubsystem = UAuraSignificanceSubsystem::Get(this))
+	{
+		ApplySignificanceSettings(SignificanceSubsystem->GetBucketSettings(SignificanceBucket));
+	}
+
+	//恢复满血满蓝，主/次属性仍然有效
+	if (const UCharacterClassInfo* CharacterClassInfo = UAuraAbilitySystemLibrary::GetCharacterClassInfo(this))
+	{
+		ApplyEffectToSelf(CharacterClassInfo->VitalAttributes, Level);
+	}
+
+	if (AuraAIController && AuraAIController->GetBrainComponent())
+	{
+		AuraAIController->GetBlackboardComponent()->SetValueAsBool(FName("Dead"), false);
+		AuraAIController->GetBlackboardComponent()->SetValueAsBool(FName("HitReacting"), false);
+		AuraAIController->GetBrainComponent()->RestartLogic();
+	}
+}
+
 void AAuraEnemy::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Aura_Enemies);
 	Super::BeginPlay();
 
 	GetCharacterMovement()->MaxWalkSpeed = BaseWalkSpeed;
 
+	BaseNetUpdateFrequency = NetUpdateFrequency;
+	if (UAuraSignificanceSubsystem* SignificanceSubsystem = UAuraSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->RegisterEnemy(this);
+	}
+
+	//此时本类已经加载完毕，这里持有的是整个职业资源包：在场期间同职业的后续生成（召唤、刷怪点、对象池扩容）不再触发加载
+	UAuraAssetManager::Get().AcquireCharacterClass(CharacterClass);
+	bAcquiredCharacterClass = true;
+
 	//设置OwnerActor和AvatarActor
 	InitAbilityActorInfo();
 	//添加（敌人）初始能力
@@ -125,6 +209,49 @@ void AAuraEnemy::BeginPlay()
 	}
 }
 
+void AAuraEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAuraSignificanceSubsystem* SignificanceSubsystem = UAuraSignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->UnregisterEnemy(this);
+	}
+	if (bAcquiredCharacterClass)
+	{
+		UAuraAssetManager::Get().ReleaseCharacterClass(CharacterClass);
+		bAcquiredCharacterClass = false;
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void AAuraEnemy::SetSignificanceBucket(EAuraSignificanceBucket Bucket, const FAuraSignificanceBucketSettings& Settings)
+{
+	SignificanceBucket = Bucket;
+	//死亡后网格体在做布娃娃模拟，不再调整；对象池复活时按记录的档位重新应用
+	if (bDead) return;
+
+	ApplySignificanceSettings(Settings);
+}
+
+void AAuraEnemy::ApplySignificanceSettings(const FAuraSignificanceBucketSettings& Settings)
+{
+	GetMesh()->SetComponentTickInterval(Settings.MeshTickInterval);
+	HealthBar->SetComponentTickEnabled(Settings.bHealthBarTick);
+	//服务器上投射物靠网格体重叠命中、移动决定位置，都不能降级，只调整同步频率
+	if (HasAuthority())
+	{
+		NetUpdateFrequency = FMath::Max(BaseNetUpdateFrequency * Settings.NetUpdateFrequencyScale, MinNetUpdateFrequency);
+		if (UAuraReplicationGraph* ReplicationGraph = UAuraReplicationGraph::Get(GetWorld()))
+		{
+			ReplicationGraph->SetActorNetUpdateFrequency(this, NetUpdateFrequency);
+		}
+	}
+	else
+	{
+		GetMesh()->SetGenerateOverlapEvents(Settings.bMeshGenerateOverlapEvents);
+		GetCharacterMovement()->SetComponentTickInterval(Settings.MovementTickInterval);
+	}
+}
+
 void AAuraEnemy::HitReactTagChanged(const FGameplayTag CallbackTag, int32 NewCount)
 {
 	
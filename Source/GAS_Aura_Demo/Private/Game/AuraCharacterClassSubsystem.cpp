@@ -0,0 +1,36 @@
+// Copyright Liupingan
+
+
+#include "Game/AuraCharacterClassSubsystem.h"
+
+#include "AbilitySystem/Data/CharacterClassInfo.h"
+#include "Engine/CurveTable.h"
+#include "Kismet/GameplayStatics.h"
+
+UAuraCharacterClassSubsystem* UAuraCharacterClassSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
+	return GameInstance ? GameInstance->GetSubsystem<UAuraCharacterClassSubsystem>() : nullptr;
+}
+
+void UAuraCharacterClassSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (!CharacterClassInfoAsset.IsNull())
+	{
+		SetCharacterClassInfo(CharacterClassInfoAsset.LoadSynchronous());
+	}
+}
+
+void UAuraCharacterClassSubsystem::SetCharacterClassInfo(UCharacterClassInfo* InCharacterClassInfo)
+{
+	CharacterClassInfo = InCharacterClassInfo;
+	DamageCoefficientCurves = FAuraDamageCoefficientCurves();
+	if (CharacterClassInfo == nullptr || CharacterClassInfo->DamageCalculationCoefficients == nullptr) return;
+
+	const UCurveTable* Coefficients = CharacterClassInfo->DamageCalculationCoefficients;
+	DamageCoefficientCurves.ArmorPenetration = Coefficients->FindCurve(FName("ArmorPenetration"), FString());
+	DamageCoefficientCurves.EffectiveArmor = Coefficients->FindCurve(FName("EffectiveArmor"), FString());
+	DamageCoefficientCurves.CriticalHitResistance = Coefficients->FindCurve(FName("CriticalHitResistance"), FString());
+}
@@ -0,0 +1,349 @@
+// Copyright Liupingan
+
+
+#include "Game/AuraCombatantSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemInterface.h"
+#include "AuraStats.h"
+#include "HAL/IConsoleManager.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+
+void FAuraSpatialGrid::Add(int32 Id, const FVector& Location, float Radius)
+{
+	if (Items.Num() <= Id)
+	{
+		Items.SetNum(Id + 1);
+	}
+	FItem& Item = Items[Id];
+	Item.Location = Location;
+	Item.Cell = ToCell(Location);
+	Item.Radius = Radius;
+	Item.bValid = true;
+	MaxItemRadius = FMath::Max(MaxItemRadius, Radius);
+
+	Cells.FindOrAdd(Item.Cell).Add(Id);
+}
+
+void FAuraSpatialGrid::Remove(int32 Id)
+{
+	if (!Contains(Id)) return;
+
+	FItem& Item = Items[Id];
+	if (TArray<int32>* Bucket = Cells.Find(Item.Cell))
+	{
+		Bucket->RemoveSingleSwap(Id, EAllowShrinking::No);
+		if (Bucket->Num() == 0)
+		{
+			Cells.Remove(Item.Cell);
+		}
+	}
+	Item.bValid = false;
+}
+
+void FAuraSpatialGrid::Move(int32 Id, const FVector& NewLocation)
+{
+	if (!Contains(Id)) return;
+
+	FItem& Item = Items[Id];
+	Item.Location = NewLocation;
+
+	const FIntPoint NewCell = ToCell(NewLocation);
+	if (NewCell == Item.Cell) return;
+
+	if (TArray<int32>* Bucket = Cells.Find(Item.Cell))
+	{
+		Bucket->RemoveSingleSwap(Id, EAllowShrinking::No);
+		if (Bucket->Num() == 0)
+		{
+			Cells.Remove(Item.Cell);
+		}
+	}
+	Item.Cell = NewCell;
+	Cells.FindOrAdd(NewCell).Add(Id);
+}
+
+UAuraCombatantSubsystem* UAuraCombatantSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UAuraCombatantSubsystem>() : nullptr;
+}
+
+bool UAuraCombatantSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAuraCombatantSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//只处理本帧移动过的存活角色，死亡和静止的角色不碰网格
+	for (const int32 Id : MovedIds)
+	{
+		if (!Combatants.IsValidIndex(Id)) continue;
+
+		FCombatantEntry& Entry = Combatants[Id];
+		Entry.bMoved = false;
+		if (Entry.bDead) continue;
+
+		if (const AActor* Actor = Entry.Actor.Get())
+		{
+			Grid.Move(Id, Actor->GetActorLocation());
+		}
+	}
+	MovedIds.Reset();
+
+#if CSV_PROFILER
+	if (FCsvProfiler::Get()->IsCapturing())
+	{
+		RecordCsvCounters();
+	}
+#endif
+}
+
+void UAuraCombatantSubsystem::RecordCsvCounters() const
+{
+#if CSV_PROFILER
+	int32 NumLiveEnemies = 0;
+	int32 NumLivePlayers = 0;
+	int32 NumActiveEffects = 0;
+	for (const FCombatantEntry& Entry : Combatants)
+	{
+		const AActor* Actor = Entry.Actor.Get();
+		if (Actor == nullptr) continue;
+
+		if (!Entry.bDead)
+		{
+			NumLiveEnemies += Entry.Team == EAuraTeam::Enemy ? 1 : 0;
+			NumLivePlayers += Entry.Team == EAuraTeam::Player ? 1 : 0;
+		}
+		if (const IAbilitySystemInterface* ASCInterface = Cast<IAbilitySystemInterface>(Actor))
+		{
+			if (const UAbilitySystemComponent* ASC = ASCInterface->GetAbilitySystemComponent())
+			{
+				NumActiveEffects += ASC->GetActiveGameplayEffects().GetNumGameplayEffects();
+			}
+		}
+	}
+
+	CSV_CUSTOM_STAT(AuraCombat, LiveEnemies, NumLiveEnemies, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AuraCombat, LivePlayers, NumLivePlayers, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AuraCombat, ActiveEffects, NumActiveEffects, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AuraCombat, ProjectilesAlive, AuraStats::GetNumProjectilesAlive(), ECsvCustomStatOp::Set);
+#endif
+}
+
+TStatId UAuraCombatantSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraCombatantSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraCombatantSubsystem::RegisterCombatant(AActor* Combatant)
+{
+	LLM_SCOPE_BYTAG(Aura_Subsystems);
+	if (!IsValid(Combatant) || !Combatant->Implements<UCombatInterface>()) return;
+	if (CombatantIds.Contains(Combatant)) return;
+
+	FCombatantEntry Entry;
+	Entry.Actor = Combatant;
+	Entry.Key = Combatant;
+	Entry.Team = UAuraAbilitySystemLibrary::GetActorTeam(Combatant);
+	Entry.bDead = ICombatInterface::Execute_IsDie(Combatant);
+
+	const int32 Id = Combatants.Add(Entry);
+	CombatantIds.Add(Combatant, Id);
+	Grid.Add(Id, Combatant->GetActorLocation(), Combatant->GetSimpleCollisionRadius());
+
+	if (USceneComponent* Root = Combatant->GetRootComponent())
+	{
+		Combatants[Id].Root = Root;
+		Combatants[Id].TransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &UAuraCombatantSubsystem::HandleCombatantMoved, Id);
+	}
+}
+
+void UAuraCombatantSubsystem::UnregisterCombatant(AActor* Combatant)
+{
+	int32 Id = INDEX_NONE;
+	if (!CombatantIds.RemoveAndCopyValue(Combatant, Id)) return;
+
+	if (USceneComponent* Root = Combatants[Id].Root.Get())
+	{
+		Root->TransformUpdated.Remove(Combatants[Id].TransformUpdatedHandle);
+	}
+	Grid.Remove(Id);
+	Combatants.RemoveAt(Id);
+}
+
+void UAuraCombatantSubsystem::SetCombatantDead(AActor* Combatant, bool bDead)
+{
+	if (const int32* Id = CombatantIds.Find(Combatant))
+	{
+		Combatants[*Id].bDead = bDead;
+		//死亡期间不跟踪位置（布娃娃、回池），复活时补一次
+		if (!bDead)
+		{
+			MarkMoved(*Id);
+		}
+	}
+}
+
+void UAuraCombatantSubsystem::HandleCombatantMoved(USceneComponent* UpdatedComponent,
+                                                   EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport,
+                                                   int32 Id)
+{
+	if (Combatants.IsValidIndex(Id) && !Combatants[Id].bDead)
+	{
+		MarkMoved(Id);
+	}
+}
+
+void UAuraCombatantSubsystem::MarkMoved(int32 Id)
+{
+	FCombatantEntry& Entry = Combatants[Id];
+	if (Entry.bMoved) return;
+
+	Entry.bMoved = true;
+	MovedIds.Add(Id);
+}
+
+bool UAuraCombatantSubsystem::IsQueryCandidate(int32 Id, const TArray<AActor*>& ActorsToIgnore) const
+{
+	const FCombatantEntry& Entry = Combatants[Id];
+	if (Entry.bDead) return false;
+
+	const AActor* Actor = Entry.Actor.Get();
+	return Actor != nullptr && !ActorsToIgnore.Contains(Actor);
+}
+
+void UAuraCombatantSubsystem::GetLiveCombatantsInRadius(const FVector& Origin, float Radius,
+                                                        const TArray<AActor*>& ActorsToIgnore,
+                                                        TArray<AActor*>& OutActors) const
+{
+	Grid.ForEachInRadius(Origin, Radius, [&](int32 Id, float DistSquared)
+	{
+		if (IsQueryCandidate(Id, ActorsToIgnore))
+		{
+			OutActors.Add(Combatants[Id].Actor.Get());
+		}
+	});
+}
+
+void UAuraCombatantSubsystem::GetLiveCombatantsInCone(const FVector& Origin, const FVector& Direction, float Radius,
+                                                      float HalfAngleDegrees, const TArray<AActor*>& ActorsToIgnore,
+                                                      TArray<AActor*>& OutActors) const
+{
+	const FVector Forward = Direction.GetSafeNormal();
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+
+	Grid.ForEachInRadius(Origin, Radius, [&](int32 Id, float DistSquared)
+	{
+		if (!IsQueryCandidate(Id, ActorsToIgnore)) return;
+
+		const FVector ToTarget = (Grid.GetLocation(Id) - Origin).GetSafeNormal();
+		if (FVector::DotProduct(Forward, ToTarget) >= CosHalfAngle)
+		{
+			OutActors.Add(Combatants[Id].Actor.Get());
+		}
+	});
+}
+
+void UAuraCombatantSubsystem::GetNearestLiveCombatants(const FVector& Origin, int32 Count, float MaxRadius,
+                                                       const TArray<AActor*>& ActorsToIgnore,
+                                                       TArray<AActor*>& OutActors) const
+{
+	if (Count <= 0) return;
+
+	TArray<TPair<float, int32>, TInlineAllocator<32>> Candidates;
+	Grid.ForEachInRadius(Origin, MaxRadius, [&](int32 Id, float DistSquared)
+	{
+		if (IsQueryCandidate(Id, ActorsToIgnore))
+		{
+			Candidates.Emplace(DistSquared, Id);
+		}
+	});
+
+	Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	const int32 NumResults = FMath::Min(Count, Candidates.Num());
+	for (int32 Index = 0; Index < NumResults; ++Index)
+	{
+		OutActors.Add(Combatants[Candidates[Index].Value].Actor.Get());
+	}
+}
+
+void UAuraCombatantSubsystem::GetLiveCombatants(TArray<AActor*>& OutActors) const
+{
+	for (const FCombatantEntry& Entry : Combatants)
+	{
+		AActor* Actor = Entry.Actor.Get();
+		if (Actor != nullptr && !Entry.bDead)
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+void UAuraCombatantSubsystem::GetLiveCombatantLocations(EAuraTeam Team, TArray<FVector>& OutLocations) const
+{
+	for (const FCombatantEntry& Entry : Combatants)
+	{
+		const AActor* Actor = Entry.Actor.Get();
+		if (Actor != nullptr && !Entry.bDead && Entry.Team == Team)
+		{
+			OutLocations.Add(Actor->GetActorLocation());
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+//用随机点对比 网格查询 与 线性遍历 的耗时，用法：Aura.Combatants.Benchmark [数量] [查询次数]
+static FAutoConsoleCommand GAuraCombatantBenchmarkCommand(
+	TEXT("Aura.Combatants.Benchmark"),
+	TEXT("Benchmark combatant radius queries: grid vs linear scan. Args: [NumCombatants=1000] [NumQueries=1000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 NumCombatants = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+		const int32 NumQueries = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1000;
+		constexpr float WorldExtent = 10000.f;
+		constexpr float QueryRadius = 800.f;
+
+		FRandomStream Random(1337);
+		TArray<FVector> Points;
+		Points.Reserve(NumCombatants);
+		FAuraSpatialGrid BenchGrid;
+		for (int32 Id = 0; Id < NumCombatants; ++Id)
+		{
+			const FVector Point(Random.FRandRange(-WorldExtent, WorldExtent), Random.FRandRange(-WorldExtent, WorldExtent), 0.f);
+			Points.Add(Point);
+			BenchGrid.Add(Id, Point, 42.f);
+		}
+
+		TArray<FVector> Origins;
+		for (int32 Index = 0; Index < NumQueries; ++Index)
+		{
+			Origins.Emplace(Random.FRandRange(-WorldExtent, WorldExtent), Random.FRandRange(-WorldExtent, WorldExtent), 0.f);
+		}
+
+		int64 GridHits = 0;
+		const double GridStart = FPlatformTime::Seconds();
+		for (const FVector& Origin : Origins)
+		{
+			BenchGrid.ForEachInRadius(Origin, QueryRadius, [&GridHits](int32, float) { ++GridHits; });
+		}
+		const double GridSeconds = FPlatformTime::Seconds() - GridStart;
+
+		int64 LinearHits = 0;
+		const double LinearStart = FPlatformTime::Seconds();
+		for (const FVector& Origin : Origins)
+		{
+			for (const FVector& Point : Points)
+			{
+				if (FVector::DistSquared(Origin, Point) <= FMath::Square(QueryRadius + 42.f)) ++LinearHits;
+			}
+		}
+		const double LinearSeconds = FPlatformTime::Seconds() - LinearStart;
+
+		UE_LOG(LogTemp, Display, TEXT("Combatant benchmark: %d combatants, %d queries | grid %.3f ms (%lld hits) | linear %.3f ms (%lld hits)"),
+		       NumCombatants, NumQueries, GridSeconds * 1000.0, GridHits, LinearSeconds * 1000.0, LinearHits);
+	}));
+#endif
@@ -0,0 +1,133 @@
+// Copyright Liupingan
+
+
+#include "Game/AuraLoadTestSubsystem.h"
+
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Net/AuraNetDriver.h"
+
+bool UAuraLoadTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	FString CsvPath;
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Value(FCommandLine::Get(), TEXT("AuraLoadTestCSV="), CsvPath);
+}
+
+void UAuraLoadTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FString CsvPath;
+	FParse::Value(FCommandLine::Get(), TEXT("AuraLoadTestCSV="), CsvPath);
+	FParse::Value(FCommandLine::Get(), TEXT("AuraLoadTestDuration="), Duration);
+
+	//换图会重建子系统，以追加方式写入同一个文件
+	const bool bWriteHeader = IFileManager::Get().FileSize(*CsvPath) <= 0;
+	CsvWriter.Reset(IFileManager::Get().CreateFileWriter(*CsvPath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if (!CsvWriter.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("AuraLoadTest: failed to open %s"), *CsvPath);
+		return;
+	}
+	if (bWriteHeader)
+	{
+		const FTCHARToUTF8 Header(TEXT("Time,NumConnections,FrameMsAvg,FrameMsMax,GameThreadMsAvg,GameThreadMsMax,")
+			TEXT("Connection,InBytesPerSec,OutBytesPerSec,InPacketsPerSec,OutPacketsPerSec,RPCsSent,MulticastRPCsSent,PingMs\n"));
+		CsvWriter->Serialize(const_cast<ANSICHAR*>(Header.Get()), Header.Length());
+	}
+	StartTime = FPlatformTime::Seconds();
+	UE_LOG(LogTemp, Display, TEXT("AuraLoadTest: writing samples to %s"), *CsvPath);
+}
+
+void UAuraLoadTestSubsystem::Deinitialize()
+{
+	if (CsvWriter.IsValid())
+	{
+		CsvWriter->Close();
+		CsvWriter.Reset();
+	}
+	Super::Deinitialize();
+}
+
+bool UAuraLoadTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAuraLoadTestSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!CsvWriter.IsValid() || NetDriver == nullptr || !NetDriver->IsServer()) return;
+
+	if (UAuraNetDriver* AuraNetDriver = Cast<UAuraNetDriver>(NetDriver))
+	{
+		AuraNetDriver->SetRPCCountingEnabled(true);
+	}
+
+	//专用服务器会按 NetServerMaxTickRate 限帧，实际负载看游戏线程耗时
+	const double FrameMs = DeltaTime * 1000.0;
+	const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	++SampleFrames;
+	FrameMsSum += FrameMs;
+	FrameMsMax = FMath::Max(FrameMsMax, FrameMs);
+	GameThreadMsSum += GameThreadMs;
+	GameThreadMsMax = FMath::Max(GameThreadMsMax, GameThreadMs);
+
+	SampleElapsed += DeltaTime;
+	if (SampleElapsed >= SampleInterval)
+	{
+		WriteSample(NetDriver);
+		SampleElapsed = 0.f;
+		SampleFrames = 0;
+		FrameMsSum = FrameMsMax = GameThreadMsSum = GameThreadMsMax = 0.0;
+	}
+
+	if (Duration > 0.0 && FPlatformTime::Seconds() - StartTime >= Duration)
+	{
+		UE_LOG(LogTemp, Display, TEXT("AuraLoadTest: duration reached, exiting"));
+		CsvWriter->Close();
+		CsvWriter.Reset();
+		FPlatformMisc::RequestExit(false, TEXT("AuraLoadTest"));
+	}
+}
+
+TStatId UAuraLoadTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraLoadTestSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraLoadTestSubsystem::WriteSample(UNetDriver* NetDriver)
+{
+	UAuraNetDriver* AuraNetDriver = Cast<UAuraNetDriver>(NetDriver);
+	const int32 MulticastRPCs = AuraNetDriver ? AuraNetDriver->ConsumeMulticastRPCsSent() : 0;
+
+	const FString FrameColumns = FString::Printf(TEXT("%.2f,%d,%.3f,%.3f,%.3f,%.3f"),
+		FPlatformTime::Seconds() - StartTime, NetDriver->ClientConnections.Num(),
+		FrameMsSum / FMath::Max(SampleFrames, 1), FrameMsMax,
+		GameThreadMsSum / FMath::Max(SampleFrames, 1), GameThreadMsMax);
+
+	FString Rows;
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection == nullptr) continue;
+
+		const int32 RPCsSent = AuraNetDriver ? AuraNetDriver->ConsumeRPCsSent(Connection) : 0;
+		Rows += FString::Printf(TEXT("%s,%s,%d,%d,%d,%d,%d,%d,%.1f\n"), *FrameColumns,
+			*Connection->LowLevelGetRemoteAddress(true),
+			Connection->InBytesPerSecond, Connection->OutBytesPerSecond,
+			Connection->InPacketsPerSecond, Connection->OutPacketsPerSecond,
+			RPCsSent, MulticastRPCs, Connection->AvgLag * 1000.f);
+	}
+	if (Rows.IsEmpty())
+	{
+		Rows = FString::Printf(TEXT("%s,,0,0,0,0,0,%d,0\n"), *FrameColumns, MulticastRPCs);
+	}
+
+	const FTCHARToUTF8 Utf8(*Rows);
+	CsvWriter->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+	CsvWriter->Flush();
+}
@@ -0,0 +1,157 @@
+// Copyright Liupingan
+
+
+#include "Game/AuraMemoryReport.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemInterface.h"
+#include "AttributeSet.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/WidgetComponent.h"
+#include "Game/AuraCombatantSubsystem.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/ArchiveCountMem.h"
+
+namespace AuraMemoryReport
+{
+	UClass* GetNativeClass(const UObject* Object)
+	{
+		UClass* Class = Object->GetClass();
+		while (Class != nullptr && !Class->HasAnyClassFlags(CLASS_Native))
+		{
+			Class = Class->GetSuperClass();
+		}
+		return Class;
+	}
+
+	//沿 Outer 链找到最近的 组件/属性集/控件/Actor，蓝图子类归到其原生父类
+	FName GetTypeName(const UObject* Object)
+	{
+		for (const UObject* It = Object; It != nullptr; It = It->GetOuter())
+		{
+			if (It->IsA<UActorComponent>() || It->IsA<UAttributeSet>() || It->IsA<UUserWidget>() || It->IsA<AActor>())
+			{
+				return GetNativeClass(It)->GetFName();
+			}
+		}
+		return GetNativeClass(Object)->GetFName();
+	}
+
+	uint64 GetObjectBytes(UObject* Object)
+	{
+		const FArchiveCountMem CountMem(Object);
+		return CountMem.GetMax() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	void AddObjectTree(UObject* Root, TSet<UObject*>& Visited, TMap<FName, uint64>& OutBytesByType)
+	{
+		if (!IsValid(Root)) return;
+
+		TArray<UObject*> Objects;
+		GetObjectsWithOuter(Root, Objects, true);
+		Objects.Add(Root);
+		for (UObject* Object : Objects)
+		{
+			bool bAlreadyVisited = false;
+			Visited.Add(Object, &bAlreadyVisited);
+			if (bAlreadyVisited) continue;
+
+			OutBytesByType.FindOrAdd(GetTypeName(Object)) += GetObjectBytes(Object);
+		}
+	}
+}
+
+FAuraCombatantMemoryReport FAuraCombatantMemoryReport::Gather(const UObject* WorldContextObject)
+{
+	FAuraCombatantMemoryReport Report;
+	const UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(WorldContextObject);
+	if (CombatantSubsystem == nullptr) return Report;
+
+	TArray<AActor*> Combatants;
+	CombatantSubsystem->GetLiveCombatants(Combatants);
+	for (AActor* Combatant : Combatants)
+	{
+		TMap<FName, uint64> BytesByType;
+		MeasureCombatant(Combatant, BytesByType);
+
+		FClassEntry& Entry = Report.Classes.FindOrAdd(Combatant->GetClass()->GetFName());
+		++Entry.NumCombatants;
+		uint64 CombatantBytes = 0;
+		for (const TPair<FName, uint64>& Pair : BytesByType)
+		{
+			Entry.BytesByType.FindOrAdd(Pair.Key) += Pair.Value;
+			CombatantBytes += Pair.Value;
+		}
+		Entry.TotalBytes += CombatantBytes;
+
+		if (UAuraAbilitySystemLibrary::GetActorTeam(Combatant) == EAuraTeam::Enemy)
+		{
+			++Report.NumEnemies;
+			Report.EnemyBytes += CombatantBytes;
+		}
+	}
+	return Report;
+}
+
+void FAuraCombatantMemoryReport::MeasureCombatant(AActor* Combatant, TMap<FName, uint64>& OutBytesByType)
+{
+	TSet<UObject*> Visited;
+	AuraMemoryReport::AddObjectTree(Combatant, Visited, OutBytesByType);
+
+	if (const APawn* Pawn = Cast<APawn>(Combatant))
+	{
+		AuraMemoryReport::AddObjectTree(Pawn->GetController(), Visited, OutBytesByType);
+		//玩家的 ASC 和属性集挂在 PlayerState 上
+		AuraMemoryReport::AddObjectTree(Pawn->GetPlayerState(), Visited, OutBytesByType);
+	}
+	if (const IAbilitySystemInterface* ASCInterface = Cast<IAbilitySystemInterface>(Combatant))
+	{
+		if (UAbilitySystemComponent* ASC = ASCInterface->GetAbilitySystemComponent())
+		{
+			AuraMemoryReport::AddObjectTree(ASC, Visited, OutBytesByType);
+			for (UAttributeSet* AttributeSet : ASC->GetSpawnedAttributes())
+			{
+				AuraMemoryReport::AddObjectTree(AttributeSet, Visited, OutBytesByType);
+			}
+		}
+	}
+
+	//血条控件的 Outer 是 GameInstance，不在角色的子对象里
+	TInlineComponentArray<UWidgetComponent*> WidgetComponents(Combatant);
+	for (const UWidgetComponent* WidgetComponent : WidgetComponents)
+	{
+		AuraMemoryReport::AddObjectTree(WidgetComponent->GetWidget(), Visited, OutBytesByType);
+	}
+}
+
+void FAuraCombatantMemoryReport::Log() const
+{
+	for (const TPair<FName, FClassEntry>& ClassPair : Classes)
+	{
+		const FClassEntry& Entry = ClassPair.Value;
+		const double NumCombatants = FMath::Max(Entry.NumCombatants, 1);
+		UE_LOG(LogTemp, Display, TEXT("%s: %d live, %.1f KB each"),
+		       *ClassPair.Key.ToString(), Entry.NumCombatants, Entry.TotalBytes / 1024.0 / NumCombatants);
+
+		TArray<TPair<FName, uint64>> SortedTypes = Entry.BytesByType.Array();
+		SortedTypes.Sort([](const TPair<FName, uint64>& A, const TPair<FName, uint64>& B) { return A.Value > B.Value; });
+		for (const TPair<FName, uint64>& TypePair : SortedTypes)
+		{
+			UE_LOG(LogTemp, Display, TEXT("    %-36s %9.1f KB"), *TypePair.Key.ToString(), TypePair.Value / 1024.0 / NumCombatants);
+		}
+	}
+	UE_LOG(LogTemp, Display, TEXT("Enemies: %d live, %.1f KB average"), NumEnemies, GetAverageEnemyBytes() / 1024.0);
+}
+
+#if !UE_BUILD_SHIPPING
+//按类输出每个存活战斗者各组件类型的平均字节数，用法：Aura.Memory.Combatants
+static FAutoConsoleCommandWithWorld GAuraCombatantMemoryCommand(
+	TEXT("Aura.Memory.Combatants"),
+	TEXT("Report bytes per component type per live combatant, grouped by combatant class"),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		FAuraCombatantMemoryReport::Gather(World).Log();
+	}));
+#endif
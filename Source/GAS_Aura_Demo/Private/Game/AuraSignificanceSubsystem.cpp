@@ -0,0 +1,173 @@
+// Copyright Liupingan
+
+
+#include "Game/AuraSignificanceSubsystem.h"
+
+#include "AuraStats.h"
+#include "SignificanceManager.h"
+#include "Character/AuraEnemy.h"
+#include "Game/AuraCombatantSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_AuraSignificance_Update, STATGROUP_AuraSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies High"), STAT_AuraSignificance_High, STATGROUP_AuraSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Medium"), STAT_AuraSignificance_Medium, STATGROUP_AuraSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Low"), STAT_AuraSignificance_Low, STATGROUP_AuraSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Dormant"), STAT_AuraSignificance_Dormant, STATGROUP_AuraSignificance);
+
+static const FName AuraEnemySignificanceTag("AuraEnemy");
+
+UAuraSignificanceSubsystem::UAuraSignificanceSubsystem()
+{
+	BucketSettings.SetNum(static_cast<uint8>(EAuraSignificanceBucket::MAX));
+
+	BucketSettings[0].MaxDistance = 2000.f;
+
+	BucketSettings[1].MaxDistance = 4500.f;
+	BucketSettings[1].MeshTickInterval = 1.f / 30.f;
+	BucketSettings[1].NetUpdateFrequencyScale = 0.5f;
+
+	BucketSettings[2].MaxDistance = 8000.f;
+	BucketSettings[2].MeshTickInterval = 0.1f;
+	BucketSettings[2].MovementTickInterval = 1.f / 30.f;
+	BucketSettings[2].bHealthBarTick = false;
+	BucketSettings[2].NetUpdateFrequencyScale = 0.2f;
+
+	//玩家投射物 15s * 500 = 7500，超出后客户端才关闭重叠
+	BucketSettings[3].MaxDistance = TNumericLimits<float>::Max();
+	BucketSettings[3].MeshTickInterval = 0.25f;
+	BucketSettings[3].MovementTickInterval = 0.1f;
+	BucketSettings[3].bMeshGenerateOverlapEvents = false;
+	BucketSettings[3].bHealthBarTick = false;
+	BucketSettings[3].NetUpdateFrequencyScale = 0.05f;
+}
+
+UAuraSignificanceSubsystem* UAuraSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UAuraSignificanceSubsystem>() : nullptr;
+}
+
+bool UAuraSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAuraSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+const FAuraSignificanceBucketSettings& UAuraSignificanceSubsystem::GetBucketSettings(EAuraSignificanceBucket Bucket) const
+{
+	return BucketSettings[FMath::Min(static_cast<int32>(Bucket), BucketSettings.Num() - 1)];
+}
+
+void UAuraSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (SignificanceManager == nullptr) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_AuraSignificance_Update);
+
+	//客户端只有本地玩家的相机；服务器取所有存活的玩家阵营战斗者，远端玩家和无头测试的 AI 替身都没有本地 PlayerController
+	Viewpoints.Reset();
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			if (const APlayerController* PC = It->Get())
+			{
+				FVector ViewLocation;
+				FRotator ViewRotation;
+				PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				Viewpoints.Emplace(ViewRotation, ViewLocation);
+			}
+		}
+	}
+	else if (const UAuraCombatantSubsystem* CombatantSubsystem = UAuraCombatantSubsystem::Get(this))
+	{
+		TArray<FVector> PlayerLocations;
+		CombatantSubsystem->GetLiveCombatantLocations(EAuraTeam::Player, PlayerLocations);
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			Viewpoints.Emplace(PlayerLocation);
+		}
+	}
+	SignificanceManager->Update(Viewpoints);
+
+	SET_DWORD_STAT(STAT_AuraSignificance_High, BucketCounts[static_cast<uint8>(EAuraSignificanceBucket::High)]);
+	SET_DWORD_STAT(STAT_AuraSignificance_Medium, BucketCounts[static_cast<uint8>(EAuraSignificanceBucket::Medium)]);
+	SET_DWORD_STAT(STAT_AuraSignificance_Low, BucketCounts[static_cast<uint8>(EAuraSignificanceBucket::Low)]);
+	SET_DWORD_STAT(STAT_AuraSignificance_Dormant, BucketCounts[static_cast<uint8>(EAuraSignificanceBucket::Dormant)]);
+}
+
+void UAuraSignificanceSubsystem::RegisterEnemy(AAuraEnemy* Enemy)
+{
+	LLM_SCOPE_BYTAG(Aura_Subsystems);
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (SignificanceManager == nullptr || !IsValid(Enemy)) return;
+
+	//档位越高重要度越低：High=3 ... Dormant=0，多个视点时 SignificanceManager 取最大值
+	constexpr float DormantIndex = static_cast<float>(EAuraSignificanceBucket::Dormant);
+	auto SignificanceFunction = [this, DormantIndex](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+	{
+		const AAuraEnemy* Enemy = CastChecked<AAuraEnemy>(ObjectInfo->GetObject());
+		return DormantIndex - static_cast<float>(CalculateBucket(Enemy, Viewpoint));
+	};
+	auto PostSignificanceFunction = [this, DormantIndex](USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+	{
+		AAuraEnemy* Enemy = CastChecked<AAuraEnemy>(ObjectInfo->GetObject());
+		const EAuraSignificanceBucket NewBucket = static_cast<EAuraSignificanceBucket>(FMath::RoundToInt32(DormantIndex - Significance));
+		if (Enemy->GetSignificanceBucket() != NewBucket)
+		{
+			OnBucketChanged(Enemy, Enemy->GetSignificanceBucket(), NewBucket);
+		}
+	};
+
+	SignificanceManager->RegisterObject(Enemy, AuraEnemySignificanceTag, SignificanceFunction,
+	                                    USignificanceManager::EPostSignificanceType::Sequential, PostSignificanceFunction);
+	++BucketCounts[static_cast<uint8>(Enemy->GetSignificanceBucket())];
+}
+
+void UAuraSignificanceSubsystem::UnregisterEnemy(AAuraEnemy* Enemy)
+{
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (SignificanceManager == nullptr) return;
+
+	if (SignificanceManager->GetManagedObject(Enemy))
+	{
+		--BucketCounts[static_cast<uint8>(Enemy->GetSignificanceBucket())];
+		SignificanceManager->UnregisterObject(Enemy);
+	}
+}
+
+EAuraSignificanceBucket UAuraSignificanceSubsystem::CalculateBucket(const AAuraEnemy* Enemy, const FTransform& Viewpoint) const
+{
+	const float DistSquared = FVector::DistSquared(Enemy->GetActorLocation(), Viewpoint.GetLocation());
+
+	uint8 Bucket = static_cast<uint8>(EAuraSignificanceBucket::Dormant);
+	for (int32 Index = 0; Index < BucketSettings.Num(); ++Index)
+	{
+		if (DistSquared <= FMath::Square(BucketSettings[Index].MaxDistance))
+		{
+			Bucket = static_cast<uint8>(FMath::Min(Index, static_cast<int32>(EAuraSignificanceBucket::Dormant)));
+			break;
+		}
+	}
+
+	//只有纯客户端按可见性降档：监听服务器的渲染结果只代表主机的相机，远端客户端正在打的敌人也会被降档
+	if (Enemy->GetNetMode() == NM_Client && !Enemy->WasRecentlyRendered(0.2f))
+	{
+		Bucket = FMath::Max(Bucket, static_cast<uint8>(NotRenderedBucket));
+	}
+	return static_cast<EAuraSignificanceBucket>(Bucket);
+}
+
+void UAuraSignificanceSubsystem::OnBucketChanged(AAuraEnemy* Enemy, EAuraSignificanceBucket OldBucket, EAuraSignificanceBucket NewBucket)
+{
+	--BucketCounts[static_cast<uint8>(OldBucket)];
+	++BucketCounts[static_cast<uint8>(NewBucket)];
+	Enemy->SetSignificanceBucket(NewBucket, GetBucketSettings(NewBucket));
+}
@@ -0,0 +1,479 @@
+// Copyright Liupingan
+
+
+#include "Game/AuraStressTestSubsystem.h"
+
+#include "AuraAssetManager.h"
+#include "AuraStats.h"
+#include "EngineUtils.h"
+#include "NavigationSystem.h"
+#include "AI/AuraStandInAIController.h"
+#include "Character/AuraCharacter.h"
+#include "Character/AuraEnemy.h"
+#include "Dom/JsonObject.h"
+#include "Game/AuraMemoryReport.h"
+#include "GameFramework/PlayerStart.h"
+#include "Interaction/CombatInterface.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Player/AuraPlayerState.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace AuraStressTest
+{
+	//补员分摊到多次，避免一帧内大量生成把 P99 拉高
+	constexpr int32 MaxSpawnsPerTopUp = 8;
+	constexpr float TopUpInterval = 1.f;
+
+	double ToMB(uint64 Bytes)
+	{
+		return static_cast<double>(Bytes) / (1024.0 * 1024.0);
+	}
+}
+
+bool UAuraStressTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("AuraStressTest"));
+}
+
+void UAuraStressTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("AuraStressStandIns="), NumStandIns);
+	FParse::Value(CommandLine, TEXT("AuraStressSpawnRadius="), SpawnRadius);
+	FParse::Value(CommandLine, TEXT("AuraStressWarmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("AuraStressDuration="), DurationSeconds);
+	FParse::Value(CommandLine, TEXT("AuraStressMaxAvgFrameMs="), MaxAvgFrameMs);
+	FParse::Value(CommandLine, TEXT("AuraStressMaxP99FrameMs="), MaxP99FrameMs);
+	FParse::Value(CommandLine, TEXT("AuraStressMaxMemoryGrowthMB="), MaxMemoryGrowthMB);
+	FParse::Value(CommandLine, TEXT("AuraStressMaxEnemyMemoryKB="), MaxEnemyMemoryKB);
+	for (FAuraStressTestEnemySpawn& Spawn : EnemySpawns)
+	{
+		const FString ClassName = StaticEnum<ECharacterClass>()->GetNameStringByValue(static_cast<int64>(Spawn.CharacterClass));
+		FParse::Value(CommandLine, *FString::Printf(TEXT("AuraStressEnemies%s="), *ClassName), Spawn.Count);
+	}
+
+	if (!FParse::Value(CommandLine, TEXT("AuraStressOutput="), OutputPath))
+	{
+		OutputPath = FPaths::ProjectSavedDir() / TEXT("StressTest/StressTest.json");
+	}
+
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UAuraStressTestSubsystem::OnWorldTickStart);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UAuraStressTestSubsystem::OnEndFrame);
+}
+
+void UAuraStressTestSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	for (const ECharacterClass CharacterClass : AcquiredCharacterClasses)
+	{
+		UAuraAssetManager::Get().ReleaseCharacterClass(CharacterClass);
+	}
+	AcquiredCharacterClasses.Reset();
+	Super::Deinitialize();
+}
+
+void UAuraStressTestSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (InWorld.GetNetMode() == NM_Client) return;
+
+	LoadedStandInClass = StandInClass.LoadSynchronous();
+	SpawnedEnemies.SetNum(EnemySpawns.Num());
+
+	for (TActorIterator<APlayerStart> It(&InWorld); It; ++It)
+	{
+		ScenarioCenter = It->GetActorLocation();
+		break;
+	}
+
+	//敌人蓝图按职业资源包异步加载，全部就绪后再开始预热，首批生成不再同步加载
+	for (const FAuraStressTestEnemySpawn& Spawn : EnemySpawns)
+	{
+		AcquiredCharacterClasses.AddUnique(Spawn.CharacterClass);
+	}
+	NumPendingClassLoads = AcquiredCharacterClasses.Num();
+	PreloadStartTime = FPlatformTime::Seconds();
+	if (NumPendingClassLoads == 0)
+	{
+		StartWarmup();
+		return;
+	}
+	for (const ECharacterClass CharacterClass : AcquiredCharacterClasses)
+	{
+		UAuraAssetManager::Get().AcquireCharacterClass(CharacterClass,
+			FStreamableDelegate::CreateUObject(this, &UAuraStressTestSubsystem::OnCharacterClassLoaded));
+	}
+}
+
+void UAuraStressTestSubsystem::OnCharacterClassLoaded()
+{
+	if (--NumPendingClassLoads == 0)
+	{
+		StartWarmup();
+	}
+}
+
+void UAuraStressTestSubsystem::StartWarmup()
+{
+	LoadedEnemyClasses.Reset();
+	for (const FAuraStressTestEnemySpawn& Spawn : EnemySpawns)
+	{
+		UClass* EnemyClass = Spawn.EnemyClass.Get();
+		if (EnemyClass == nullptr)
+		{
+			//未登记到职业资源包的类只能退回同步加载
+			UE_LOG(LogTemp, Warning, TEXT("AuraStressTest: %s is not in a character class bundle, loading synchronously"), *Spawn.EnemyClass.ToString());
+			EnemyClass = Spawn.EnemyClass.LoadSynchronous();
+		}
+		UE_CLOG(EnemyClass == nullptr, LogTemp, Error, TEXT("AuraStressTest: failed to load %s"), *Spawn.EnemyClass.ToString());
+		LoadedEnemyClasses.Add(EnemyClass);
+	}
+
+	Phase = EPhase::Warmup;
+	PhaseStartTime = FPlatformTime::Seconds();
+	ClassPreloadMs = (PhaseStartTime - PreloadStartTime) * 1000.0;
+	TopUp();
+	UE_LOG(LogTemp, Display, TEXT("AuraStressTest: enemy classes preloaded in %.1f ms; warmup %.0fs, measure %.0fs, %d stand-ins"),
+	       ClassPreloadMs, WarmupSeconds, DurationSeconds, NumStandIns);
+}
+
+bool UAuraStressTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAuraStressTestSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Phase == EPhase::Idle || Phase == EPhase::Done) return;
+
+	TopUpElapsed += DeltaTime;
+	if (TopUpElapsed >= AuraStressTest::TopUpInterval)
+	{
+		TopUpElapsed = 0.f;
+		TopUp();
+	}
+
+	const double PhaseElapsed = FPlatformTime::Seconds() - PhaseStartTime;
+	if (Phase == EPhase::Warmup && PhaseElapsed >= WarmupSeconds)
+	{
+		Phase = EPhase::Measure;
+		PhaseStartTime = FPlatformTime::Seconds();
+		FrameMs.Reset();
+		ProjectilesAtMeasureStart = AuraStats::GetNumProjectilesSpawned();
+		NumEnemyDeathsDuringMeasure = 0;
+		MemoryAtMeasureStart = FPlatformMemory::GetStats().UsedPhysical;
+		PeakMemoryDuringMeasure = MemoryAtMeasureStart;
+		UE_LOG(LogTemp, Display, TEXT("AuraStressTest: measuring"));
+	}
+	else if (Phase == EPhase::Measure)
+	{
+		PeakMemoryDuringMeasure = FMath::Max(PeakMemoryDuringMeasure, FPlatformMemory::GetStats().UsedPhysical);
+		if (PhaseElapsed >= DurationSeconds)
+		{
+			Finish();
+		}
+	}
+}
+
+TStatId UAuraStressTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraStressTestSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraStressTestSubsystem::PruneDeadEnemies()
+{
+	for (TArray<TWeakObjectPtr<AAuraEnemy>>& Enemies : SpawnedEnemies)
+	{
+		Enemies.RemoveAllSwap([this](const TWeakObjectPtr<AAuraEnemy>& Enemy)
+		{
+			if (!Enemy.IsValid()) return true;
+			if (!ICombatInterface::Execute_IsDie(Enemy.Get())) return false;
+
+			if (Phase == EPhase::Measure)
+			{
+				++NumEnemyDeathsDuringMeasure;
+			}
+			return true;
+		});
+	}
+}
+
+void UAuraStressTestSubsystem::TopUp()
+{
+	PruneDeadEnemies();
+	for (int32 SpawnIndex = 0; SpawnIndex < EnemySpawns.Num(); ++SpawnIndex)
+	{
+		const TArray<TWeakObjectPtr<AAuraEnemy>>& Enemies = SpawnedEnemies[SpawnIndex];
+		const int32 NumMissing = FMath::Min(EnemySpawns[SpawnIndex].Count - Enemies.Num(), AuraStressTest::MaxSpawnsPerTopUp);
+		for (int32 Index = 0; Index < NumMissing; ++Index)
+		{
+			SpawnEnemy(SpawnIndex);
+		}
+	}
+
+	//替身的 ASC 挂在 PlayerState 上，重新 Possess 会重复授予技能，所以阵亡后连同控制器一起换新
+	for (auto It = StandIns.CreateIterator(); It; ++It)
+	{
+		AAuraStandInAIController* StandIn = It->Get();
+		APawn* StandInPawn = StandIn ? StandIn->GetPawn() : nullptr;
+		if (StandInPawn != nullptr && !ICombatInterface::Execute_IsDie(StandInPawn)) continue;
+
+		if (StandInPawn != nullptr)
+		{
+			StandInPawn->SetLifeSpan(5.f);
+		}
+		if (StandIn != nullptr)
+		{
+			StandIn->UnPossess();
+			StandIn->Destroy();
+		}
+		It.RemoveCurrentSwap();
+	}
+	const int32 NumMissingStandIns = FMath::Min(NumStandIns - StandIns.Num(), AuraStressTest::MaxSpawnsPerTopUp);
+	for (int32 Index = 0; Index < NumMissingStandIns; ++Index)
+	{
+		SpawnStandIn();
+	}
+}
+
+void UAuraStressTestSubsystem::SpawnStandIn()
+{
+	LLM_SCOPE_BYTAG(Aura_Players);
+	FVector Location;
+	if (LoadedStandInClass == nullptr || !FindSpawnLocation(Location)) return;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	AAuraStandInAIController* StandIn = GetWorld()->SpawnActor<AAuraStandInAIController>(
+		AAuraStandInAIController::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+	if (StandIn == nullptr) return;
+
+	if (!IsValid(Cast<AAuraPlayerState>(StandIn->PlayerState)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("AuraStressTest: game mode does not create AAuraPlayerState for AI controllers"));
+		StandIn->Destroy();
+		return;
+	}
+
+	AAuraCharacter* Character = GetWorld()->SpawnActor<AAuraCharacter>(LoadedStandInClass, Location, FRotator::ZeroRotator, SpawnParams);
+	if (Character == nullptr)
+	{
+		StandIn->Destroy();
+		return;
+	}
+
+	StandIn->Possess(Character);
+	StandIns.Add(StandIn);
+	++NumStandInsSpawned;
+}
+
+void UAuraStressTestSubsystem::SpawnEnemy(int32 SpawnIndex)
+{
+	LLM_SCOPE_BYTAG(Aura_Enemies);
+	UClass* EnemyClass = LoadedEnemyClasses[SpawnIndex];
+	FVector Location;
+	if (EnemyClass == nullptr || !FindSpawnLocation(Location)) return;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	const FRotator Rotation(0.f, FMath::FRandRange(0.f, 360.f), 0.f);
+	AAuraEnemy* Enemy = GetWorld()->SpawnActor<AAuraEnemy>(EnemyClass, Location, Rotation, SpawnParams);
+	if (Enemy == nullptr) return;
+
+	if (Enemy->GetController() == nullptr)
+	{
+		Enemy->SpawnDefaultController();
+	}
+	SpawnedEnemies[SpawnIndex].Add(Enemy);
+	++NumEnemiesSpawned;
+}
+
+bool UAuraStressTestSubsystem::FindSpawnLocation(FVector& OutLocation) const
+{
+	//胶囊体半高，避免生成在地面以下
+	static const FVector SpawnOffset(0.f, 0.f, 100.f);
+
+	if (const UNavigationSystemV1* NavSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		FNavLocation NavLocation;
+		if (NavSystem->GetRandomReachablePointInRadius(ScenarioCenter, SpawnRadius, NavLocation))
+		{
+			OutLocation = NavLocation.Location + SpawnOffset;
+			return true;
+		}
+	}
+
+	const FVector2D Offset = FMath::RandPointInCircle(SpawnRadius);
+	OutLocation = ScenarioCenter + FVector(Offset.X, Offset.Y, 0.f) + SpawnOffset;
+	return true;
+}
+
+void UAuraStressTestSubsystem::Finish()
+{
+	//最后一次补员之后阵亡的也计入
+	PruneDeadEnemies();
+	NumProjectilesDuringMeasure = AuraStats::GetNumProjectilesSpawned() - ProjectilesAtMeasureStart;
+	Phase = EPhase::Done;
+
+	TArray<float> SortedFrameMs = FrameMs;
+	SortedFrameMs.Sort();
+	const int32 NumFrames = SortedFrameMs.Num();
+	double FrameMsSum = 0.0;
+	for (const float Ms : SortedFrameMs)
+	{
+		FrameMsSum += Ms;
+	}
+	const double AvgFrameMs = NumFrames > 0 ? FrameMsSum / NumFrames : 0.0;
+	const double P99FrameMs = NumFrames > 0 ? SortedFrameMs[FMath::Clamp(FMath::CeilToInt(NumFrames * 0.99) - 1, 0, NumFrames - 1)] : 0.0;
+	const double MaxFrameMs = NumFrames > 0 ? SortedFrameMs.Last() : 0.0;
+
+	const uint64 MemoryAtEnd = FPlatformMemory::GetStats().UsedPhysical;
+	const double MemoryGrowthMB = AuraStressTest::ToMB(MemoryAtEnd) - AuraStressTest::ToMB(MemoryAtMeasureStart);
+	const double PeakMemoryGrowthMB = AuraStressTest::ToMB(PeakMemoryDuringMeasure) - AuraStressTest::ToMB(MemoryAtMeasureStart);
+	const FAuraCombatantMemoryReport CombatantMemory = FAuraCombatantMemoryReport::Gather(this);
+	const double EnemyMemoryKB = CombatantMemory.GetAverageEnemyBytes() / 1024.0;
+
+	TArray<FString> Failures;
+	if (NumFrames == 0 || NumEnemiesSpawned == 0 || NumStandInsSpawned == 0)
+	{
+		Failures.Add(FString::Printf(TEXT("scenario did not run: %d frames, %d enemies, %d stand-ins spawned"),
+			NumFrames, NumEnemiesSpawned, NumStandInsSpawned));
+	}
+	//没有投射物或没有敌人阵亡说明双方没有真正交战，帧时间和内存数据不代表战斗负载
+	if (NumProjectilesDuringMeasure == 0 || NumEnemyDeathsDuringMeasure == 0)
+	{
+		Failures.Add(FString::Printf(TEXT("no combat during measurement: %d projectiles spawned, %d enemies died"),
+			NumProjectilesDuringMeasure, NumEnemyDeathsDuringMeasure));
+	}
+	if (AvgFrameMs > MaxAvgFrameMs)
+	{
+		Failures.Add(FString::Printf(TEXT("avg frame %.3f ms > %.3f ms"), AvgFrameMs, MaxAvgFrameMs));
+	}
+	if (P99FrameMs > MaxP99FrameMs)
+	{
+		Failures.Add(FString::Printf(TEXT("p99 frame %.3f ms > %.3f ms"), P99FrameMs, MaxP99FrameMs));
+	}
+	if (MemoryGrowthMB > MaxMemoryGrowthMB)
+	{
+		Failures.Add(FString::Printf(TEXT("memory growth %.1f MB > %.1f MB"), MemoryGrowthMB, MaxMemoryGrowthMB));
+	}
+	if (EnemyMemoryKB > MaxEnemyMemoryKB)
+	{
+		Failures.Add(FString::Printf(TEXT("enemy memory %.1f KB > %.1f KB"), EnemyMemoryKB, MaxEnemyMemoryKB));
+	}
+	const bool bPassed = Failures.IsEmpty();
+
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("Map"), GetWorld()->GetMapName());
+	Root->SetBoolField(TEXT("Passed"), bPassed);
+	Root->SetNumberField(TEXT("WarmupSeconds"), WarmupSeconds);
+	Root->SetNumberField(TEXT("DurationSeconds"), DurationSeconds);
+	Root->SetNumberField(TEXT("StandIns"), NumStandIns);
+	Root->SetNumberField(TEXT("StandInsSpawned"), NumStandInsSpawned);
+	Root->SetNumberField(TEXT("EnemiesSpawned"), NumEnemiesSpawned);
+	Root->SetNumberField(TEXT("ClassPreloadMs"), ClassPreloadMs);
+	Root->SetNumberField(TEXT("ProjectilesSpawned"), NumProjectilesDuringMeasure);
+	Root->SetNumberField(TEXT("EnemyDeaths"), NumEnemyDeathsDuringMeasure);
+
+	TArray<TSharedPtr<FJsonValue>> EnemyValues;
+	for (int32 SpawnIndex = 0; SpawnIndex < EnemySpawns.Num(); ++SpawnIndex)
+	{
+		const TSharedRef<FJsonObject> EnemyObject = MakeShared<FJsonObject>();
+		EnemyObject->SetStringField(TEXT("CharacterClass"),
+			StaticEnum<ECharacterClass>()->GetNameStringByValue(static_cast<int64>(EnemySpawns[SpawnIndex].CharacterClass)));
+		EnemyObject->SetStringField(TEXT("EnemyClass"), EnemySpawns[SpawnIndex].EnemyClass.ToString());
+		EnemyObject->SetNumberField(TEXT("Count"), EnemySpawns[SpawnIndex].Count);
+		EnemyValues.Add(MakeShared<FJsonValueObject>(EnemyObject));
+	}
+	Root->SetArrayField(TEXT("Enemies"), EnemyValues);
+
+	const TSharedRef<FJsonObject> FrameObject = MakeShared<FJsonObject>();
+	FrameObject->SetNumberField(TEXT("Frames"), NumFrames);
+	FrameObject->SetNumberField(TEXT("AvgMs"), AvgFrameMs);
+	FrameObject->SetNumberField(TEXT("P99Ms"), P99FrameMs);
+	FrameObject->SetNumberField(TEXT("MaxMs"), MaxFrameMs);
+	Root->SetObjectField(TEXT("ServerFrame"), FrameObject);
+
+	const TSharedRef<FJsonObject> MemoryObject = MakeShared<FJsonObject>();
+	MemoryObject->SetNumberField(TEXT("StartMB"), AuraStressTest::ToMB(MemoryAtMeasureStart));
+	MemoryObject->SetNumberField(TEXT("EndMB"), AuraStressTest::ToMB(MemoryAtEnd));
+	MemoryObject->SetNumberField(TEXT("GrowthMB"), MemoryGrowthMB);
+	MemoryObject->SetNumberField(TEXT("PeakGrowthMB"), PeakMemoryGrowthMB);
+	MemoryObject->SetNumberField(TEXT("PerEnemyKB"), EnemyMemoryKB);
+
+	//每类战斗者 每个实例 各组件类型的 KB
+	const TSharedRef<FJsonObject> CombatantsObject = MakeShared<FJsonObject>();
+	for (const TPair<FName, FAuraCombatantMemoryReport::FClassEntry>& ClassPair : CombatantMemory.Classes)
+	{
+		const double NumCombatants = FMath::Max(ClassPair.Value.NumCombatants, 1);
+		const TSharedRef<FJsonObject> ClassObject = MakeShared<FJsonObject>();
+		ClassObject->SetNumberField(TEXT("Live"), ClassPair.Value.NumCombatants);
+		ClassObject->SetNumberField(TEXT("KBEach"), ClassPair.Value.TotalBytes / 1024.0 / NumCombatants);
+		const TSharedRef<FJsonObject> TypesObject = MakeShared<FJsonObject>();
+		for (const TPair<FName, uint64>& TypePair : ClassPair.Value.BytesByType)
+		{
+			TypesObject->SetNumberField(TypePair.Key.ToString(), TypePair.Value / 1024.0 / NumCombatants);
+		}
+		ClassObject->SetObjectField(TEXT("KBByType"), TypesObject);
+		CombatantsObject->SetObjectField(ClassPair.Key.ToString(), ClassObject);
+	}
+	MemoryObject->SetObjectField(TEXT("Combatants"), CombatantsObject);
+	Root->SetObjectField(TEXT("Memory"), MemoryObject);
+
+	const TSharedRef<FJsonObject> BudgetObject = MakeShared<FJsonObject>();
+	BudgetObject->SetNumberField(TEXT("MaxAvgFrameMs"), MaxAvgFrameMs);
+	BudgetObject->SetNumberField(TEXT("MaxP99FrameMs"), MaxP99FrameMs);
+	BudgetObject->SetNumberField(TEXT("MaxMemoryGrowthMB"), MaxMemoryGrowthMB);
+	BudgetObject->SetNumberField(TEXT("MaxEnemyMemoryKB"), MaxEnemyMemoryKB);
+	Root->SetObjectField(TEXT("Budgets"), BudgetObject);
+
+	TArray<TSharedPtr<FJsonValue>> FailureValues;
+	for (const FString& Failure : Failures)
+	{
+		FailureValues.Add(MakeShared<FJsonValueString>(Failure));
+	}
+	Root->SetArrayField(TEXT("Failures"), FailureValues);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("AuraStressTest: failed to write %s"), *OutputPath);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("AuraStressTest: %s | avg %.3f ms, p99 %.3f ms, max %.3f ms over %d frames | memory +%.1f MB, %.1f KB per enemy | %s"),
+		bPassed ? TEXT("PASSED") : TEXT("FAILED"), AvgFrameMs, P99FrameMs, MaxFrameMs, NumFrames, MemoryGrowthMB, EnemyMemoryKB, *OutputPath);
+	CombatantMemory.Log();
+	for (const FString& Failure : Failures)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AuraStressTest: %s"), *Failure);
+	}
+
+	FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1, TEXT("AuraStressTest"));
+}
+
+void UAuraStressTestSubsystem::OnWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	//从世界 Tick 开始计时，专用服务器限帧的睡眠发生在这之前，不计入
+	if (TickedWorld == GetWorld())
+	{
+		FrameStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void UAuraStressTestSubsystem::OnEndFrame()
+{
+	if (Phase == EPhase::Measure && FrameStartTime > 0.0)
+	{
+		FrameMs.Add(static_cast<float>((FPlatformTime::Seconds() - FrameStartTime) * 1000.0));
+	}
+	FrameStartTime = 0.0;
+}
@@ -0,0 +1,246 @@
+// Copyright Liupingan
+
+
+#include "Game/AuraSummonSubsystem.h"
+
+#include "AuraAssetManager.h"
+#include "AuraStats.h"
+#include "Character/AuraEnemy.h"
+#include "Engine/StreamableManager.h"
+#include "Interaction/CombatInterface.h"
+
+UAuraSummonSubsystem* UAuraSummonSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UAuraSummonSubsystem>() : nullptr;
+}
+
+bool UAuraSummonSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAuraSummonSubsystem::Deinitialize()
+{
+	for (TPair<TObjectKey<AActor>, FRegisteredSummoner>& Pair : RegisteredSummoners)
+	{
+		ReleaseSummoner(Pair.Value);
+	}
+	RegisteredSummoners.Empty();
+	MinionClassLoads.Empty();
+	Super::Deinitialize();
+}
+
+TStatId UAuraSummonSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraSummonSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraSummonSubsystem::RegisterSummoner(AActor* Summoner, TConstArrayView<TSoftClassPtr<APawn>> MinionClasses)
+{
+	if (!IsValid(Summoner)) return;
+
+	FRegisteredSummoner& Registered = RegisteredSummoners.FindOrAdd(Summoner);
+	Registered.Summoner = Summoner;
+	for (const TSoftClassPtr<APawn>& MinionClass : MinionClasses)
+	{
+		const FSoftObjectPath MinionClassPath = MinionClass.ToSoftObjectPath();
+		if (MinionClassPath.IsNull() || Registered.RequestedClasses.Contains(MinionClassPath)) continue;
+
+		Registered.RequestedClasses.Add(MinionClassPath);
+		TOptional<ECharacterClass> AcquiredClass;
+		Registered.LoadHandles.Add(UAuraAssetManager::Get().RequestEnemyClass(MinionClassPath, AcquiredClass));
+		if (AcquiredClass.IsSet())
+		{
+			Registered.AcquiredClasses.Add(AcquiredClass.GetValue());
+		}
+	}
+}
+
+void UAuraSummonSubsystem::ReleaseSummoner(FRegisteredSummoner& Registered)
+{
+	for (const ECharacterClass CharacterClass : Registered.AcquiredClasses)
+	{
+		UAuraAssetManager::Get().ReleaseCharacterClass(CharacterClass);
+	}
+	Registered.AcquiredClasses.Reset();
+	Registered.LoadHandles.Reset();
+}
+
+bool UAuraSummonSubsystem::RequestSpawn(AActor* Summoner, const TSoftClassPtr<APawn>& MinionClass, const FTransform& SpawnTransform)
+{
+	if (!IsValid(Summoner) || MinionClass.IsNull() || GetRemainingMinionSlots(Summoner) <= 0) return false;
+
+	FPendingSpawn& PendingSpawn = PendingSpawns.AddDefaulted_GetRef();
+	PendingSpawn.Summoner = Summoner;
+	PendingSpawn.SummonerKey = Summoner;
+	PendingSpawn.MinionClass = MinionClass;
+	PendingSpawn.SpawnTransform = SpawnTransform;
+	++MinionCounts.FindOrAdd(Summoner);
+	return true;
+}
+
+int32 UAuraSummonSubsystem::GetNumMinions(const AActor* Summoner) const
+{
+	const int32* Count = MinionCounts.Find(Summoner);
+	return Count ? *Count : 0;
+}
+
+int32 UAuraSummonSubsystem::GetRemainingMinionSlots(const AActor* Summoner) const
+{
+	return FMath::Max(MaxMinionsPerSummoner - GetNumMinions(Summoner), 0);
+}
+
+void UAuraSummonSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	PruneDeadMinions();
+	PruneSummoners();
+	if (PendingSpawns.Num() == 0) return;
+
+	//按先后顺序生成，超出数量或时间预算的留到下一帧；类还在加载的请求跳过，不在这里同步加载
+	const double BudgetEndTime = FPlatformTime::Seconds() + SpawnBudgetMs / 1000.0;
+	int32 NumProcessed = 0;
+	for (int32 Index = 0; Index < PendingSpawns.Num() && NumProcessed < MaxSpawnsPerFrame;)
+	{
+		bool bLoading = false;
+		UClass* MinionClass = PendingSpawns[Index].Summoner.IsValid() ? ResolveMinionClass(PendingSpawns[Index].MinionClass, bLoading) : nullptr;
+		if (bLoading)
+		{
+			++Index;
+			continue;
+		}
+
+		const FPendingSpawn PendingSpawn = PendingSpawns[Index];
+		PendingSpawns.RemoveAt(Index, 1, EAllowShrinking::No);
+		++NumProcessed;
+
+		APawn* Minion = MinionClass ? SpawnMinion(PendingSpawn, MinionClass) : nullptr;
+		if (Minion)
+		{
+			FActiveMinion& ActiveMinion = ActiveMinions.AddDefaulted_GetRef();
+			ActiveMinion.Minion = Minion;
+			ActiveMinion.Summoner = PendingSpawn.SummonerKey;
+		}
+		else if (int32* Count = MinionCounts.Find(PendingSpawn.SummonerKey))
+		{
+			if (--*Count <= 0)
+			{
+				MinionCounts.Remove(PendingSpawn.SummonerKey);
+			}
+		}
+
+		if (FPlatformTime::Seconds() >= BudgetEndTime) break;
+	}
+}
+
+UClass* UAuraSummonSubsystem::ResolveMinionClass(const TSoftClassPtr<APawn>& MinionClass, bool& bOutLoading)
+{
+	bOutLoading = false;
+	const FSoftObjectPath MinionClassPath = MinionClass.ToSoftObjectPath();
+	if (UClass* LoadedClass = MinionClass.Get())
+	{
+		MinionClassLoads.Remove(MinionClassPath);
+		return LoadedClass;
+	}
+
+	//召唤者登记时发起的预加载还没完成，或请求没经过登记：在这里补一个异步加载，类可用之前请求一直留在队列里
+	TSharedPtr<FStreamableHandle>& Handle = MinionClassLoads.FindOrAdd(MinionClassPath);
+	if (!Handle.IsValid())
+	{
+		Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MinionClassPath);
+	}
+	bOutLoading = Handle.IsValid() && Handle->IsLoadingInProgress();
+	if (bOutLoading) return nullptr;
+
+	MinionClassLoads.Remove(MinionClassPath);
+	UClass* LoadedClass = MinionClass.Get();
+	//加载结束仍取不到类：路径无效，丢弃这个请求
+	UE_CLOG(LoadedClass == nullptr, LogTemp, Warning, TEXT("Summon: failed to load minion class %s"), *MinionClassPath.ToString());
+	return LoadedClass;
+}
+
+APawn* UAuraSummonSubsystem::SpawnMinion(const FPendingSpawn& PendingSpawn, TSubclassOf<APawn> MinionClass)
+{
+	LLM_SCOPE_BYTAG(Aura_Enemies);
+	AActor* Summoner = PendingSpawn.Summoner.Get();
+	if (AAuraEnemy* PooledMinion = AcquirePooledMinion(MinionClass))
+	{
+		PooledMinion->SetOwner(Summoner);
+		PooledMinion->ReactivateFromPool(PendingSpawn.SpawnTransform.GetLocation(), PendingSpawn.SpawnTransform.Rotator());
+		return PooledMinion;
+	}
+
+	APawn* Minion = GetWorld()->SpawnActorDeferred<APawn>(MinionClass, PendingSpawn.SpawnTransform, Summoner,
+	                                                      Cast<APawn>(Summoner), ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (Minion == nullptr) return nullptr;
+
+	if (AAuraEnemy* Enemy = Cast<AAuraEnemy>(Minion))
+	{
+		Enemy->bPooledMinion = true;
+	}
+	Minion->FinishSpawning(PendingSpawn.SpawnTransform);
+	if (Minion->GetController() == nullptr)
+	{
+		Minion->SpawnDefaultController();
+	}
+	return Minion;
+}
+
+AAuraEnemy* UAuraSummonSubsystem::AcquirePooledMinion(TSubclassOf<APawn> MinionClass)
+{
+	FAuraMinionPool* Pool = Pools.Find(MinionClass);
+	while (Pool && Pool->Minions.Num() > 0)
+	{
+		AAuraEnemy* Minion = Pool->Minions.Pop(EAllowShrinking::No);
+		if (IsValid(Minion)) return Minion;
+	}
+	return nullptr;
+}
+
+void UAuraSummonSubsystem::ReleaseMinion(AAuraEnemy* Minion)
+{
+	if (!IsValid(Minion)) return;
+
+	FAuraMinionPool& Pool = Pools.FindOrAdd(Minion->GetClass());
+	if (Pool.Minions.Num() >= MaxPooledMinionsPerClass)
+	{
+		Minion->Destroy();
+		return;
+	}
+	Minion->DeactivateForPool();
+	Pool.Minions.Add(Minion);
+}
+
+void UAuraSummonSubsystem::PruneDeadMinions()
+{
+	for (int32 Index = ActiveMinions.Num() - 1; Index >= 0; --Index)
+	{
+		const APawn* Minion = ActiveMinions[Index].Minion.Get();
+		const bool bAlive = IsValid(Minion) && !(Minion->Implements<UCombatInterface>() && ICombatInterface::Execute_IsDie(Minion));
+		if (bAlive) continue;
+
+		if (int32* Count = MinionCounts.Find(ActiveMinions[Index].Summoner))
+		{
+			if (--*Count <= 0)
+			{
+				MinionCounts.Remove(ActiveMinions[Index].Summoner);
+			}
+		}
+		ActiveMinions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void UAuraSummonSubsystem::PruneSummoners()
+{
+	for (auto It = RegisteredSummoners.CreateIterator(); It; ++It)
+	{
+		const AActor* Summoner = It->Value.Summoner.Get();
+		const bool bAlive = IsValid(Summoner) && !(Summoner->Implements<UCombatInterface>() && ICombatInterface::Execute_IsDie(Summoner));
+		if (bAlive) continue;
+
+		ReleaseSummoner(It->Value);
+		It.RemoveCurrent();
+	}
+}
@@ -9,3 +9,8 @@ int32 ICombatInterface::GetPlayerLevel()
 	return 1;
 }
 
+EAuraTeam ICombatInterface::GetTeam() const
+{
+	return EAuraTeam::Neutral;
+}
+
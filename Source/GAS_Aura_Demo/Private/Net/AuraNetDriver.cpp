@@ -0,0 +1,36 @@
+// Copyright Liupingan
+
+
+#include "Net/AuraNetDriver.h"
+
+void UAuraNetDriver::ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms,
+                                           FFrame* Stack, UObject* SubObject)
+{
+	if (bCountRPCs && Actor && Function)
+	{
+		if (Function->FunctionFlags & FUNC_NetMulticast)
+		{
+			++MulticastRPCsSent;
+		}
+		else if (const UNetConnection* Connection = Actor->GetNetConnection())
+		{
+			++RPCsSentByConnection.FindOrAdd(Connection);
+		}
+	}
+
+	Super::ProcessRemoteFunction(Actor, Function, Parameters, OutParms, Stack, SubObject);
+}
+
+int32 UAuraNetDriver::ConsumeRPCsSent(const UNetConnection* Connection)
+{
+	int32 Count = 0;
+	RPCsSentByConnection.RemoveAndCopyValue(Connection, Count);
+	return Count;
+}
+
+int32 UAuraNetDriver::ConsumeMulticastRPCsSent()
+{
+	const int32 Count = MulticastRPCsSent;
+	MulticastRPCsSent = 0;
+	return Count;
+}
@@ -0,0 +1,215 @@
+// Copyright Liupingan
+
+
+#include "Net/AuraReplicationGraph.h"
+
+#include "Actor/AuraEffectActor.h"
+#include "AuraStats.h"
+#include "Actor/AuraProjectile.h"
+#include "Character/AuraCharacterBase.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerState.h"
+#include "ReplicationGraphTypes.h"
+
+DECLARE_CYCLE_STAT(TEXT("Aura RepGraph ServerReplicateActors"), STAT_AuraRepGraph_ServerReplicateActors, STATGROUP_Net);
+
+UAuraReplicationGraph* UAuraReplicationGraph::Get(const UWorld* World)
+{
+	const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	return NetDriver ? Cast<UAuraReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+}
+
+bool UAuraReplicationGraph::InitClassReplicationInfo(UClass* ActorClass)
+{
+	//沿继承链向上直到已处理过的类：运行中才加载的蓝图类也能用上自己的 NetUpdateFrequency 和 NetCullDistanceSquared
+	bool bActorClassInitialized = false;
+	for (UClass* Class = ActorClass; Class != nullptr; Class = Class->GetSuperClass())
+	{
+		bool bAlreadyInitialized = false;
+		InitializedClasses.Add(TObjectKey<UClass>(Class), &bAlreadyInitialized);
+		if (bAlreadyInitialized) break;
+
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (ActorCDO == nullptr || !ActorCDO->GetIsReplicated()) continue;
+
+		FClassReplicationInfo ClassInfo;
+		ClassInfo.DistancePriorityScale = 1.f;
+		ClassInfo.StarvationPriorityScale = 1.f;
+		ClassInfo.ActorChannelFrameTimeout = 4;
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->NetUpdateFrequency);
+		ClassInfo.SetCullDistanceSquared(ActorCDO->NetCullDistanceSquared);
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+		bActorClassInitialized |= Class == ActorClass;
+	}
+	return bActorClassInitialized;
+}
+
+void UAuraReplicationGraph::InitGlobalGraphNodes()
+{
+	PreAllocateRepList(3, 12);
+	PreAllocateRepList(6, 12);
+	PreAllocateRepList(128, 64);
+	PreAllocateRepList(512, 16);
+
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = FVector2D(SpatialBiasX, SpatialBiasY);
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UAuraReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* OwnerNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(OwnerNode, RepGraphConnection);
+	OwnerNodes.Add(RepGraphConnection->NetConnection, OwnerNode);
+}
+
+void UAuraReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	TObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection> OwnerNode;
+	if (OwnerNodes.RemoveAndCopyValue(NetConnection, OwnerNode))
+	{
+		//节点随连接一起销毁，里面的 Actor 不用再逐个移除
+		for (auto It = OwnerRelevantActorNodes.CreateIterator(); It; ++It)
+		{
+			if (It->Value == OwnerNode)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+	Super::RemoveClientConnection(NetConnection);
+}
+
+EAuraClassRepNodeMapping UAuraReplicationGraph::GetMappingPolicy(const AActor* Actor) const
+{
+	if (Actor->IsA<APlayerState>()) return EAuraClassRepNodeMapping::PlayerState;
+	if (Actor->bAlwaysRelevant) return EAuraClassRepNodeMapping::RelevantAllConnections;
+	if (Actor->bOnlyRelevantToOwner) return EAuraClassRepNodeMapping::OwnerRelevant;
+	if (Actor->IsA<AAuraCharacterBase>() || Actor->IsA<AAuraProjectile>()) return EAuraClassRepNodeMapping::Spatialize_Dynamic;
+	if (Actor->IsA<AAuraEffectActor>()) return EAuraClassRepNodeMapping::Spatialize_Static;
+	return EAuraClassRepNodeMapping::Spatialize_Dormancy;
+}
+
+UReplicationGraphNode_AlwaysRelevant_ForConnection* UAuraReplicationGraph::GetOwnerNodeForConnection(UNetConnection* Connection) const
+{
+	const TObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection>* OwnerNode = OwnerNodes.Find(Connection);
+	return OwnerNode ? OwnerNode->Get() : nullptr;
+}
+
+void UAuraReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	//该类的第一个 Actor 在类设置生成前就已拷贝了父类的设置，这里补上
+	if (InitClassReplicationInfo(ActorInfo.Class))
+	{
+		GlobalInfo.Settings = GlobalActorReplicationInfoMap.GetClassInfo(ActorInfo.Class);
+	}
+
+	switch (GetMappingPolicy(ActorInfo.Actor))
+	{
+	case EAuraClassRepNodeMapping::PlayerState:
+	case EAuraClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::OwnerRelevant:
+		ActorsWithoutNetConnection.Add({ActorInfo.Actor, GetReplicationGraphFrame()});
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	}
+}
+
+void UAuraReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Actor))
+	{
+	case EAuraClassRepNodeMapping::PlayerState:
+	case EAuraClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		SetActorDestructionInfoToIgnoreDistanceCulling(ActorInfo.GetActor());
+		break;
+	case EAuraClassRepNodeMapping::OwnerRelevant:
+		RemoveOwnerRelevantActor(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	}
+}
+
+void UAuraReplicationGraph::RemoveOwnerRelevantActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	TWeakObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection> OwnerNode;
+	if (OwnerRelevantActorNodes.RemoveAndCopyValue(ActorInfo.Actor, OwnerNode))
+	{
+		if (OwnerNode.IsValid())
+		{
+			OwnerNode->NotifyRemoveNetworkActor(ActorInfo);
+		}
+		return;
+	}
+
+	ActorsWithoutNetConnection.RemoveAllSwap([&ActorInfo](const FPendingOwnerRelevantActor& Pending)
+	{
+		return Pending.Actor == ActorInfo.Actor;
+	}, EAllowShrinking::No);
+}
+
+void UAuraReplicationGraph::RoutePendingOwnerRelevantActors()
+{
+	const uint32 Frame = GetReplicationGraphFrame();
+	for (int32 Index = ActorsWithoutNetConnection.Num() - 1; Index >= 0; --Index)
+	{
+		const FPendingOwnerRelevantActor& Pending = ActorsWithoutNetConnection[Index];
+		AActor* Actor = Pending.Actor.Get();
+		UNetConnection* Connection = Actor ? Actor->GetNetConnection() : nullptr;
+		if (Actor != nullptr && Connection == nullptr && Frame - Pending.AddedFrame < MaxFramesWithoutNetConnection) continue;
+
+		if (UReplicationGraphNode_AlwaysRelevant_ForConnection* OwnerNode = GetOwnerNodeForConnection(Connection))
+		{
+			OwnerNode->NotifyAddNetworkActor(FNewReplicatedActorInfo(Actor));
+			OwnerRelevantActorNodes.Add(Actor, OwnerNode);
+		}
+		else if (Actor != nullptr)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("Owner-relevant actor %s has no owning connection node, it will not replicate"), *GetNameSafe(Actor));
+		}
+		ActorsWithoutNetConnection.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+int32 UAuraReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraRepGraph_ServerReplicateActors);
+	AURA_CSV_EXCLUSIVE_SCOPE(AuraNet, ServerReplicateActors);
+
+	RoutePendingOwnerRelevantActors();
+
+	return Super::ServerReplicateActors(DeltaSeconds);
+}
+
+void UAuraReplicationGraph::SetActorNetUpdateFrequency(const AActor* Actor, float NetUpdateFrequency)
+{
+	if (FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Actor))
+	{
+		GlobalInfo->Settings.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(NetUpdateFrequency);
+	}
+}
@@ -5,15 +5,22 @@
 
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AuraGameplayTags.h"
+#include "AuraStats.h"
 #include "EnhancedInputSubsystems.h"
 #include "GameplayTagContainer.h"
 #include "NavigationPath.h"
 #include "NavigationSystem.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
 #include "Components/SplineComponent.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "EngineUtils.h"
+#include "Game/AuraCombatantSubsystem.h"
 #include "GameFramework/Character.h"
 #include "Input/AuraInputComponent.h"
 #include "Interaction/EnemyInterface.h"
+#include "Misc/CommandLine.h"
 #include "ProfilingDebugging/CookStats.h"
 #include "UI/Widget/DamageTextComponent.h"
 
@@ -29,22 +36,81 @@ void AAuraPlayerController::PlayerTick(float DeltaTime)
 
 	CursorTrace();
 	AutoRun();
+
+#if !UE_BUILD_SHIPPING
+	if (bBotEnabled) TickBot(DeltaTime);
+#endif
+}
+
+bool AAuraPlayerController::GetCursorHitResult(FHitResult& OutHit) const
+{
+#if !UE_BUILD_SHIPPING
+	if (bBotEnabled)
+	{
+		OutHit = BotCursorHit;
+		return OutHit.bBlockingHit;
+	}
+#endif
+	return GetHitResultUnderCursor(ECC_Visibility, false, OutHit);
+}
+
+void AAuraPlayerController::QueueDamageNumber(float DamageAmount, ACharacter* TargetCharacter, bool bIsBlockedHit, bool bIsCriticalHit)
+{
+	if (!IsValid(TargetCharacter)) return;
+
+	FAuraDamageNumber& DamageNumber = PendingDamageNumbers.AddDefaulted_GetRef();
+	DamageNumber.Target = TargetCharacter;
+	DamageNumber.Damage = DamageAmount;
+	DamageNumber.bIsBlockedHit = bIsBlockedHit;
+	DamageNumber.bIsCriticalHit = bIsCriticalHit;
+
+	if (!bDamageNumbersFlushPending)
+	{
+		bDamageNumbersFlushPending = true;
+		GetWorldTimerManager().SetTimerForNextTick(this, &AAuraPlayerController::FlushDamageNumbers);
+	}
+}
+
+void AAuraPlayerController::FlushDamageNumbers()
+{
+	AURA_COMBAT_SCOPE(STAT_AuraFlushDamageNumbers, AuraNet);
+	bDamageNumbersFlushPending = false;
+
+	for (int32 Start = 0; Start < PendingDamageNumbers.Num(); Start += MaxDamageNumbersPerRPC)
+	{
+		const int32 Count = FMath::Min(MaxDamageNumbersPerRPC, PendingDamageNumbers.Num() - Start);
+		ClientShowDamageNumbers(TArray<FAuraDamageNumber>(PendingDamageNumbers.GetData() + Start, Count));
+	}
+	PendingDamageNumbers.Reset();
+}
+
+void AAuraPlayerController::ClientShowDamageNumbers_Implementation(const TArray<FAuraDamageNumber>& DamageNumbers)
+{
+	AURA_COMBAT_SCOPE(STAT_AuraShowDamageNumbers, AuraUI);
+	for (const FAuraDamageNumber& DamageNumber : DamageNumbers)
+	{
+		ShowDamageNumber(DamageNumber);
+	}
 }
 
-void AAuraPlayerController::ShowDamageNumber_Implementation(float DamageAmount, ACharacter* TargetCharacter, bool bIsBlockedHit, bool bIsCriticalHit)
+void AAuraPlayerController::ShowDamageNumber(const FAuraDamageNumber& DamageNumber)
 {
+	LLM_SCOPE_BYTAG(Aura_UI);
+	ACharacter* TargetCharacter = DamageNumber.Target;
 	if (IsValid(TargetCharacter) && DamageTextComponentClass && IsLocalController())
 	{
 		UDamageTextComponent* DamageTextComponent=NewObject<UDamageTextComponent>(TargetCharacter,DamageTextComponentClass);
 		DamageTextComponent->RegisterComponent();
 		DamageTextComponent->AttachToComponent(TargetCharacter->GetRootComponent(),FAttachmentTransformRules::KeepRelativeTransform);
 		DamageTextComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
-		DamageTextComponent->SetDamageText(DamageAmount, bIsBlockedHit, bIsCriticalHit);
+		DamageTextComponent->SetDamageText(DamageNumber.Damage, DamageNumber.bIsBlockedHit, DamageNumber.bIsCriticalHit);
+		AuraStats::DamageNumberSpawned();
 	}
 }
 
 void AAuraPlayerController::AutoRun()
 {
+	AURA_COMBAT_SCOPE(STAT_AuraAutoRun, AuraInput);
 	if (!bAutoRun) return;
 	if (APawn* ControlledPawn = GetPawn())
 	{
@@ -64,7 +130,8 @@ void AAuraPlayerController::AutoRun()
 
 void AAuraPlayerController::CursorTrace()
 {
-	GetHitResultUnderCursor(ECC_Visibility, false, CursorHit);
+	AURA_COMBAT_SCOPE(STAT_AuraCursorTrace, AuraInput);
+	GetCursorHitResult(CursorHit);
 	if (!CursorHit.bBlockingHit) return;
 
 	LastActor = ThisActor;
@@ -97,6 +164,15 @@ void AAuraPlayerController::BeginPlay()
 	InputModeData.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock); //将鼠标锁定在视口内
 	InputModeData.SetHideCursorDuringCapture(false); //鼠标被捕获时是否隐藏
 	SetInputMode(InputModeData); //设置给控制器
+
+#if !UE_BUILD_SHIPPING
+	bBotEnabled = IsLocalController() && FParse::Param(FCommandLine::Get(), TEXT("AuraBot"));
+	if (bBotEnabled)
+	{
+		BotRandom.Initialize(FPlatformProcess::GetCurrentProcessId());
+		BotIdleTimeRemaining = BotRandom.FRandRange(1.f, 3.f);
+	}
+#endif
 }
 
 void AAuraPlayerController::SetupInputComponent()
@@ -186,7 +262,7 @@ void AAuraPlayerController::AbilityInputTagHeld(FGameplayTag InputTag)
 	{
 		FollowTime += GetWorld()->GetDeltaSeconds();
 
-		if (GetHitResultUnderCursor(ECC_Visibility, false, CursorHit))
+		if (GetCursorHitResult(CursorHit))
 		{
 			CachedDestination = CursorHit.ImpactPoint;
 		}
@@ -207,3 +283,154 @@ UAuraAbilitySystemComponent* AAuraPlayerController::GetASC()
 	}
 	return AuraAbilitySystemComponent;
 }
+
+#if !UE_BUILD_SHIPPING
+void AAuraPlayerController::TickBot(float DeltaTime)
+{
+	if (GetPawn() == nullptr) return;
+
+	//按住阶段：和真实玩家一样每帧触发 Held，时间到了再 Released
+	if (BotHeldInputTag.IsValid())
+	{
+		AbilityInputTagHeld(BotHeldInputTag);
+		BotHoldTimeRemaining -= DeltaTime;
+		if (BotHoldTimeRemaining <= 0.f)
+		{
+			AbilityInputTagReleased(BotHeldInputTag);
+			BotHeldInputTag = FGameplayTag();
+			BotIdleTimeRemaining = BotRandom.FRandRange(0.2f, 1.5f);
+		}
+		return;
+	}
+
+	BotIdleTimeRemaining -= DeltaTime;
+	if (BotIdleTimeRemaining <= 0.f)
+	{
+		BotStartNextAction();
+	}
+}
+
+void AAuraPlayerController::BotStartNextAction()
+{
+	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
+	const FVector Origin = GetPawn()->GetActorLocation();
+
+	BotCursorHit = FHitResult();
+	BotCursorHit.bBlockingHit = true;
+	FGameplayTag InputTag = GameplayTags.InputTag_LMB;
+
+	AActor* Target = BotFindTarget();
+	if (Target && BotRandom.FRand() < 0.6f)
+	{
+		//攻击：光标落在敌人身上，大部分时间用左键技能，偶尔按其他技能键
+		BotCursorHit.HitObjectHandle = FActorInstanceHandle(Target);
+		BotCursorHit.Component = Cast<UPrimitiveComponent>(Target->GetRootComponent());
+		BotCursorHit.Location = BotCursorHit.ImpactPoint = Target->GetActorLocation();
+		if (BotRandom.FRand() > 0.7f)
+		{
+			const FGameplayTag OtherTags[] = {
+				GameplayTags.InputTag_RMB, GameplayTags.InputTag_1, GameplayTags.InputTag_2,
+				GameplayTags.InputTag_3, GameplayTags.InputTag_4
+			};
+			InputTag = OtherTags[BotRandom.RandHelper(UE_ARRAY_COUNT(OtherTags))];
+		}
+	}
+	else
+	{
+		//移动：短按左键点地面，走自动寻路
+		FNavLocation Destination;
+		const UNavigationSystemV1* NavSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+		if (NavSystem && NavSystem->GetRandomReachablePointInRadius(Origin, 1500.f, Destination))
+		{
+			BotCursorHit.Location = BotCursorHit.ImpactPoint = Destination.Location;
+		}
+		else
+		{
+			BotCursorHit.Location = BotCursorHit.ImpactPoint = Origin + FVector(BotRandom.VRand().GetSafeNormal2D() * 800.f);
+		}
+	}
+
+	CursorTrace();
+	AbilityInputTagPressed(InputTag);
+	BotHeldInputTag = InputTag;
+	BotHoldTimeRemaining = BotRandom.FRandRange(0.05f, 0.3f);
+}
+
+AActor* AAuraPlayerController::BotFindTarget() const
+{
+	const UAuraCombatantSubsystem* Combatants = UAuraCombatantSubsystem::Get(this);
+	if (Combatants == nullptr) return nullptr;
+
+	TArray<AActor*> Nearest;
+	Combatants->GetNearestLiveCombatants(GetPawn()->GetActorLocation(), 4, 2000.f, {GetPawn()}, Nearest);
+	for (AActor* Candidate : Nearest)
+	{
+		if (UAuraAbilitySystemLibrary::IsNotFriend(GetPawn(), Candidate)) return Candidate;
+	}
+	return nullptr;
+}
+#endif
+
+#if !UE_BUILD_SHIPPING
+//对比 逐条RPC 与 批量RPC 的参数大小，用法：Aura.DamageNumbers.Measure [目标数=30]，需在联网会话中执行
+static FAutoConsoleCommandWithWorldAndArgs GAuraDamageNumbersMeasureCommand(
+	TEXT("Aura.DamageNumbers.Measure"),
+	TEXT("Logs RPC count and payload bits for one AoE worth of damage numbers: per-hit vs batched. Args: [NumTargets=30]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumTargets = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 30;
+		const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		const UNetConnection* Connection = NetDriver ? (NetDriver->ServerConnection ? NetDriver->ServerConnection.Get()
+			: (NetDriver->ClientConnections.Num() > 0 ? NetDriver->ClientConnections[0].Get() : nullptr)) : nullptr;
+		UPackageMap* Map = Connection ? Connection->PackageMap : nullptr;
+		if (Map == nullptr || NumTargets <= 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aura.DamageNumbers.Measure needs a networked session"));
+			return;
+		}
+
+		TArray<ACharacter*> Characters;
+		for (TActorIterator<ACharacter> It(World); It; ++It)
+		{
+			Characters.Add(*It);
+		}
+		if (Characters.Num() == 0) return;
+
+		FRandomStream Random(1337);
+		TArray<FAuraDamageNumber> Batch;
+		for (int32 Index = 0; Index < NumTargets; ++Index)
+		{
+			FAuraDamageNumber& DamageNumber = Batch.AddDefaulted_GetRef();
+			DamageNumber.Target = Characters[Index % Characters.Num()];
+			DamageNumber.Damage = Random.FRandRange(5.f, 150.f);
+			DamageNumber.bIsCriticalHit = Random.FRand() < 0.2f;
+		}
+
+		//旧方式：每个目标一次RPC，参数为 对象引用 + float + 两个 bool
+		FNetBitWriter PerHitWriter(Map, 0);
+		for (const FAuraDamageNumber& DamageNumber : Batch)
+		{
+			UObject* TargetObject = DamageNumber.Target;
+			float Damage = DamageNumber.Damage;
+			bool bBlocked = DamageNumber.bIsBlockedHit;
+			bool bCritical = DamageNumber.bIsCriticalHit;
+			Map->SerializeObject(PerHitWriter, ACharacter::StaticClass(), TargetObject);
+			PerHitWriter << Damage;
+			PerHitWriter.SerializeBits(&bBlocked, 1);
+			PerHitWriter.SerializeBits(&bCritical, 1);
+		}
+
+		FNetBitWriter BatchWriter(Map, 0);
+		int32 NumEntries = Batch.Num();
+		BatchWriter << NumEntries;
+		for (FAuraDamageNumber& DamageNumber : Batch)
+		{
+			bool bOutSuccess = false;
+			DamageNumber.NetSerialize(BatchWriter, Map, bOutSuccess);
+		}
+
+		const int32 NumBatchedRPCs = FMath::DivideAndRoundUp(NumTargets, 64);
+		UE_LOG(LogTemp, Display, TEXT("Damage numbers for %d targets | per-hit: %d reliable RPCs, %lld payload bits | batched: %d unreliable RPC(s), %lld payload bits"),
+		       NumTargets, NumTargets, PerHitWriter.GetNumBits(), NumBatchedRPCs, BatchWriter.GetNumBits());
+	}));
+#endif
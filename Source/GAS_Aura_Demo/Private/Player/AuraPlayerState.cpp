@@ -6,7 +6,10 @@
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAttributeSet.h"
 #include "Character/AuraCharacter.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 AAuraPlayerState::AAuraPlayerState()
 {
@@ -23,7 +26,24 @@ AAuraPlayerState::AAuraPlayerState()
 void AAuraPlayerState::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(AAuraPlayerState,Level)
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraPlayerState, Level, Params);
+}
+
+void AAuraPlayerState::SetPlayerLevel(int32 InLevel)
+{
+	if (Level == InLevel) return;
+
+	Level = InLevel;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, Level, this);
+
+	//与等级相关的派生属性（MaxHealth/MaxMana 等）下一帧重算
+	if (UAuraAttributeSet* AuraAttributeSet = Cast<UAuraAttributeSet>(AttributeSet))
+	{
+		AuraAttributeSet->MarkLevelDirty();
+	}
 }
 
 UAbilitySystemComponent* AAuraPlayerState::GetAbilitySystemComponent() const
@@ -35,3 +55,24 @@ void AAuraPlayerState::OnRep_Level(int32 OldLevel)
 {
 	
 }
+
+#if !UE_BUILD_SHIPPING
+//在服务器上给所有玩家升级，用于检查派生属性的重算开销，用法：Aura.Attributes.LevelUp [等级数=1]
+static FAutoConsoleCommandWithWorldAndArgs GAuraAttributesLevelUpCommand(
+	TEXT("Aura.Attributes.LevelUp"),
+	TEXT("Raises the level of every player on the server so level-dependent derived attributes are recomputed. Args: [Levels=1]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Aura.Attributes.LevelUp must run on the server"));
+			return;
+		}
+
+		const int32 Levels = FMath::Max(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1, 1);
+		for (TActorIterator<AAuraPlayerState> It(World); It; ++It)
+		{
+			It->SetPlayerLevel(It->GetPlayerLevel() + Levels);
+		}
+	}));
+#endif
@@ -3,6 +3,7 @@
 
 #include "UI/HUD/AuraHUD.h"
 
+#include "AuraStats.h"
 #include "UI/Widget/AuraUserWidget.h"
 #include "UI/WidgetController/AttributeMenuWidgetController.h"
 #include "UI/WidgetController/OverlayWidgetController.h"
@@ -32,6 +33,7 @@ UAttributeMenuWidgetController* AAuraHUD::GetAttributeMenuWidgetController(const
 
 void AAuraHUD::InitOverlay(APlayerController* PC, APlayerState* PS, UAbilitySystemComponent* ASC, UAttributeSet* AS)
 {
+	LLM_SCOPE_BYTAG(Aura_UI);
 	checkf(OverlayWidgetClass, TEXT("Overlay Widget Class is null, please fill BP_auraHUD"));
 	checkf(OverlayWidgetControllerClass, TEXT("Overlay Widget Controller Class is null, please fill BP_auraHUD"));
 
@@ -4,18 +4,24 @@
 #include "UI/WidgetController/AttributeMenuWidgetController.h"
 #include "AbilitySystem/Data/AttributeInfo.h"
 #include "AuraGameplayTags.h"
+#include "AuraStats.h"
 #include "AbilitySystem/AuraAttributeSet.h"
 
 void UAttributeMenuWidgetController::BindCallbacksToDependencies()
 {
 	UAuraAttributeSet* AS = CastChecked<UAuraAttributeSet>(AttributeSet);
 
+	CacheAttributeInfos();
+
 	for (auto& Pair : AS->TagsToAttributesMap)
 	{
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Pair.Value()).AddLambda(
-			[this,Pair](const FOnAttributeChangeData& Data)
+		const int32 InfoIndex = AttributeInfo ? AttributeInfo->FindAttributeInfoIndexForTag(Pair.Key, true) : INDEX_NONE;
+		if (InfoIndex == INDEX_NONE) continue;
+
+		BindAttributeChangeCoalesced(Pair.Value(),
+			[this,InfoIndex,Pair](float NewValue)
 			{
-				BroadcastAttributeInfo(Pair.Key, Pair.Value());
+				BroadcastAttributeInfo(InfoIndex, Pair.Value());
 			}
 		);
 	}
@@ -23,21 +29,37 @@ void UAttributeMenuWidgetController::BindCallbacksToDependencies()
 
 void UAttributeMenuWidgetController::BroadcastInitialValues()
 {
+	AURA_COMBAT_SCOPE(STAT_AuraWidgetControllerBroadcast, AuraUI);
 	UAuraAttributeSet* AS = CastChecked<UAuraAttributeSet>(AttributeSet);
 
 	check(AttributeInfo);
 
+	if (CachedAttributeInfos.Num() != AttributeInfo->AttributeInformation.Num())
+	{
+		CacheAttributeInfos();
+	}
+
 	for (auto& Pair : AS->TagsToAttributesMap)
 	{
-		BroadcastAttributeInfo(Pair.Key, Pair.Value());
+		BroadcastAttributeInfo(AttributeInfo->FindAttributeInfoIndexForTag(Pair.Key, true), Pair.Value());
 	}
 }
 
-void UAttributeMenuWidgetController::BroadcastAttributeInfo(const FGameplayTag& Tag,const FGameplayAttribute& Attribute) const
+void UAttributeMenuWidgetController::CacheAttributeInfos()
 {
-	FAuraAttributeInfo Info = AttributeInfo->FindAttributeInfoForTag(Tag);
-	Info.AttributeValue = Attribute.GetNumericValue(AttributeSet);
-	AttributeInfoDelegate.Broadcast(Info);
+	CachedAttributeInfos.Reset();
+	if (AttributeInfo)
+	{
+		CachedAttributeInfos = AttributeInfo->AttributeInformation;
+	}
 }
 
+void UAttributeMenuWidgetController::BroadcastAttributeInfo(int32 InfoIndex,const FGameplayAttribute& Attribute)
+{
+	if (!CachedAttributeInfos.IsValidIndex(InfoIndex)) return;
 
+	//只复制数值，名称与描述（FText）沿用缓存
+	FAuraAttributeInfo& Info = CachedAttributeInfos[InfoIndex];
+	Info.AttributeValue = Attribute.GetNumericValue(AttributeSet);
+	AttributeInfoDelegate.Broadcast(Info);
+}
@@ -3,6 +3,9 @@
 
 #include "UI/WidgetController/AuraWidgetController.h"
 
+#include "AbilitySystemComponent.h"
+#include "AuraStats.h"
+
 void UAuraWidgetController::SetPlayerControllerParams(const FWidgetControllerParams& WCParams)
 {
 	PlayerController=WCParams.PlayerController;
@@ -20,4 +23,57 @@ void UAuraWidgetController::BindCallbacksToDependencies()
 {
 }
 
+void UAuraWidgetController::BindAttributeChangeCoalesced(const FGameplayAttribute& Attribute,
+                                                        TFunction<void(float)>&& Broadcast)
+{
+	const int32 BindingIndex = CoalescedAttributeBindings.Num();
+	FCoalescedAttributeBinding& Binding = CoalescedAttributeBindings.AddDefaulted_GetRef();
+	Binding.Attribute = Attribute;
+	Binding.Broadcast = MoveTemp(Broadcast);
+
+	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddLambda(
+		[this, BindingIndex](const FOnAttributeChangeData& Data)
+		{
+			MarkAttributeBindingDirty(BindingIndex);
+		}
+	);
+}
+
+void UAuraWidgetController::MarkAttributeBindingDirty(int32 BindingIndex)
+{
+	CoalescedAttributeBindings[BindingIndex].bDirty = true;
+	if (bAttributeFlushPending) return;
+
+	bAttributeFlushPending = true;
+	if (PlayerController == nullptr)
+	{
+		FlushDirtyAttributes();
+		return;
+	}
+
+	FTimerManager& TimerManager = PlayerController->GetWorldTimerManager();
+	if (UIUpdateInterval > 0.f)
+	{
+		TimerManager.SetTimer(AttributeFlushTimerHandle, this, &UAuraWidgetController::FlushDirtyAttributes,
+		                      UIUpdateInterval, false);
+	}
+	else
+	{
+		TimerManager.SetTimerForNextTick(this, &UAuraWidgetController::FlushDirtyAttributes);
+	}
+}
+
+void UAuraWidgetController::FlushDirtyAttributes()
+{
+	AURA_COMBAT_SCOPE(STAT_AuraWidgetControllerBroadcast, AuraUI);
+	bAttributeFlushPending = false;
+	if (!IsValid(AbilitySystemComponent)) return;
 
+	//同一帧内多次变化只广播最后的值
+	for (FCoalescedAttributeBinding& Binding : CoalescedAttributeBindings)
+	{
+		if (!Binding.bDirty) continue;
+		Binding.bDirty = false;
+		Binding.Broadcast(AbilitySystemComponent->GetNumericAttribute(Binding.Attribute));
+	}
+}
@@ -3,11 +3,14 @@
 
 #include "UI/WidgetController/OverlayWidgetController.h"
 
+#include "AuraGameplayTags.h"
+#include "AuraStats.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAttributeSet.h"
 
 void UOverlayWidgetController::BroadcastInitialValues()
 {
+	AURA_COMBAT_SCOPE(STAT_AuraWidgetControllerBroadcast, AuraUI);
 	const UAuraAttributeSet* AuraAttributeSet=CastChecked<UAuraAttributeSet>(AttributeSet);
 	OnHealthChanged.Broadcast(AuraAttributeSet->GetHealth());
 	OnMaxHealthChanged.Broadcast(AuraAttributeSet->GetMaxHealth());
@@ -18,44 +21,49 @@ void UOverlayWidgetController::BroadcastInitialValues()
 void UOverlayWidgetController::BindCallbacksToDependencies()
 {
 	const UAuraAttributeSet* AuraAttributeSet=CastChecked<UAuraAttributeSet>(AttributeSet);
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AuraAttributeSet->GetHealthAttribute()).AddLambda(
-			[this](const FOnAttributeChangeData& Data)
-			{
-				OnHealthChanged.Broadcast(Data.NewValue);
-			}
-		);
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AuraAttributeSet->GetMaxHealthAttribute()).AddLambda(
-			[this](const FOnAttributeChangeData& Data)
-			{
-				OnMaxHealthChanged.Broadcast(Data.NewValue);
-			}
-		);
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AuraAttributeSet->GetManaAttribute()).AddLambda(
-			[this](const FOnAttributeChangeData& Data)
-			{
-				OnManaChanged.Broadcast(Data.NewValue);
-			}
-		);
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AuraAttributeSet->GetMaxManaAttribute()).AddLambda(
-			[this](const FOnAttributeChangeData& Data)
-			{
-				OnMaxManaChanged.Broadcast(Data.NewValue);
-			}
-		);
+	BindAttributeChangeCoalesced(AuraAttributeSet->GetHealthAttribute(),
+		[this](float NewValue) { OnHealthChanged.Broadcast(NewValue); });
+	BindAttributeChangeCoalesced(AuraAttributeSet->GetMaxHealthAttribute(),
+		[this](float NewValue) { OnMaxHealthChanged.Broadcast(NewValue); });
+	BindAttributeChangeCoalesced(AuraAttributeSet->GetManaAttribute(),
+		[this](float NewValue) { OnManaChanged.Broadcast(NewValue); });
+	BindAttributeChangeCoalesced(AuraAttributeSet->GetMaxManaAttribute(),
+		[this](float NewValue) { OnMaxManaChanged.Broadcast(NewValue); });
+
+	BuildMessageWidgetRowIndex();
 
 	Cast<UAuraAbilitySystemComponent>(AbilitySystemComponent)->EffectAssetTags.AddLambda(
 		[this](const FGameplayTagContainer& TagContainer)
 		{
+			const FGameplayTag& MessageTag = FAuraGameplayTags::Get().Message;
 			for (const FGameplayTag& Tag : TagContainer)
 			{
-				FGameplayTag MessageTag=FGameplayTag::RequestGameplayTag(FName("Message"));
-				if (Tag.MatchesTag(MessageTag))
+				if (!Tag.MatchesTag(MessageTag)) continue;
+
+				//数据表中没有配置该消息时直接忽略
+				if (const FUIWidgetRow* const* Row = MessageWidgetRowsByTag.Find(Tag))
 				{
-					const FUIWidgetRow* Row=GetDataTableRowByTag<FUIWidgetRow>(MessageWidgetDataTable,Tag);
-					MessageWidgetRowDelegate.Broadcast(*Row);
+					MessageWidgetRowDelegate.Broadcast(**Row);
 				}
 			}
 		}
 	);
 }
 
+void UOverlayWidgetController::BuildMessageWidgetRowIndex()
+{
+	MessageWidgetRowsByTag.Reset();
+	if (MessageWidgetDataTable == nullptr) return;
+
+	MessageWidgetDataTable->ForeachRow<FUIWidgetRow>(TEXT("BuildMessageWidgetRowIndex"),
+		[this](const FName& RowName, const FUIWidgetRow& Row)
+		{
+			//与原先按标签名查行保持一致：行名即标签名，行名不是有效标签时退回行内的 GameplayTag
+			const FGameplayTag RowNameTag = FGameplayTag::RequestGameplayTag(RowName, false);
+			const FGameplayTag Tag = RowNameTag.IsValid() ? RowNameTag : Row.GameplayTag;
+			if (Tag.IsValid())
+			{
+				MessageWidgetRowsByTag.Add(Tag, &Row);
+			}
+		});
+}
@@ -0,0 +1,102 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraAILODSubsystem.generated.h"
+
+class AAuraAIController;
+class APawn;
+
+USTRUCT()
+struct FAuraAILODLevel
+{
+	GENERATED_BODY()
+
+	FAuraAILODLevel() {}
+	FAuraAILODLevel(float InMaxDistance, float InTickInterval) : MaxDistance(InMaxDistance), TickInterval(InTickInterval) {}
+
+	//离最近玩家的距离不超过该值时使用本级
+	UPROPERTY(EditDefaultsOnly)
+	float MaxDistance = 0.f;
+
+	//控制器与行为树组件的 Tick 间隔，0 表示每帧
+	UPROPERTY(EditDefaultsOnly)
+	float TickInterval = 0.f;
+};
+
+/**
+ * 仅服务器：按与最近玩家的距离和战斗状态给 AI 控制器分配 Tick 频率，
+ * 每帧只在预算时间内评估一部分控制器，并限制满频控制器的数量；
+ * 行为树的间隔由 UAuraBehaviorTreeComponent 作为下限应用。
+ * 另有每帧的 AI 总预算：行为树 Tick 和 LOD 评估的耗时累加，用完后未交战的行为树推迟到后面的帧
+ */
+UCLASS(Config=Game)
+class GAS_AURA_DEMO_API UAuraAILODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UAuraAILODSubsystem();
+
+	static UAuraAILODSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterController(AAuraAIController* Controller);
+	void UnregisterController(AAuraAIController* Controller);
+
+	/** 本帧 AI 预算已用完且该控制器未交战时返回 true；已推迟的时间达到上限后不再推迟 */
+	bool ShouldDeferBehaviorTreeTick(const AAuraAIController* Controller, float DeferredSeconds);
+
+	/** 把一次行为树 Tick 的耗时计入本帧 AI 预算 */
+	void AddFrameAITime(double Seconds);
+
+private:
+	struct FControllerEntry
+	{
+		TWeakObjectPtr<AAuraAIController> Controller;
+		int32 LODLevel = INDEX_NONE;
+	};
+
+	static bool IsEngaged(const APawn* Pawn);
+	void ResetFrameAITimeIfNewFrame();
+
+	int32 EvaluateLODLevel(const AAuraAIController* Controller, TConstArrayView<FVector> PlayerLocations) const;
+	void ApplyLODLevel(FControllerEntry& Entry, int32 NewLODLevel);
+	void RemoveControllerAt(int32 Index);
+
+	//由近到远排列，超出最后一级距离的使用最后一级
+	UPROPERTY(Config)
+	TArray<FAuraAILODLevel> LODLevels;
+
+	//有战斗目标或正在受击的敌人在该距离内始终满频
+	UPROPERTY(Config)
+	float EngagedMaxDistance = 4000.f;
+
+	//每帧用于评估 LOD 的时间预算（毫秒），只限制本子系统的评估循环，不包括行为树和感知本身的开销
+	UPROPERTY(Config)
+	float LODEvaluationBudgetMs = 0.25f;
+
+	//每帧所有 AI（行为树 Tick + LOD 评估）的时间预算（毫秒），超出后未交战的行为树推迟
+	UPROPERTY(Config)
+	float AIFrameBudgetMs = 2.f;
+
+	//单个行为树最多连续推迟的时间，避免远处的 AI 一直饿死
+	UPROPERTY(Config)
+	float MaxBehaviorTreeDeferSeconds = 0.5f;
+
+	//同时满频运行的控制器上限，超出的降一级
+	UPROPERTY(Config)
+	int32 MaxFullRateControllers = 48;
+
+	TArray<FControllerEntry> Controllers;
+	int32 EvaluationCursor = 0;
+	int32 NumFullRateControllers = 0;
+
+	uint64 FrameAITimeFrame = 0;
+	double FrameAITimeSeconds = 0.0;
+};
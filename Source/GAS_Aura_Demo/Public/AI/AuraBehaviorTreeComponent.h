@@ -0,0 +1,29 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "AuraBehaviorTreeComponent.generated.h"
+
+/**
+ * 把行为树的每帧开销计入 AuraAI 的 CSV/stat 分类，并应用 UAuraAILODSubsystem 分配的 Tick 间隔；
+ * 本帧 AI 预算用完时跳过这次 Tick，跳过的时间累加到下一次真正的 Tick 里
+ */
+UCLASS()
+class GAS_AURA_DEMO_API UAuraBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	//0 表示不限制，按行为树自己安排的间隔运行
+	void SetLODTickInterval(float InLODTickInterval);
+
+private:
+	void ClampTickIntervalToLOD();
+
+	float LODTickInterval = 0.f;
+	float DeferredDeltaTime = 0.f;
+};
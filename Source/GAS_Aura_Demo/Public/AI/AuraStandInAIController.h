@@ -0,0 +1,46 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "GameplayTagContainer.h"
+#include "AuraStandInAIController.generated.h"
+
+class UAuraAbilitySystemComponent;
+
+/**
+ * 压力测试中代替真人玩家的 AI：拥有自己的 PlayerState（AAuraCharacter 的 ASC 挂在 PlayerState 上），
+ * 追最近的敌对战斗者，进入射程后按住/松开 LMB 输入标签，技能走与真人玩家相同的激活路径
+ */
+UCLASS()
+class GAS_AURA_DEMO_API AAuraStandInAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AAuraStandInAIController();
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	virtual void OnUnPossess() override;
+
+	UPROPERTY(EditDefaultsOnly, Category="StressTest")
+	float ThinkInterval = 0.5f;
+
+	UPROPERTY(EditDefaultsOnly, Category="StressTest")
+	float AttackRange = 800.f;
+
+	UPROPERTY(EditDefaultsOnly, Category="StressTest")
+	float SearchRadius = 5000.f;
+
+private:
+	void Think();
+	AActor* FindTarget() const;
+	UAuraAbilitySystemComponent* GetAuraASC() const;
+	void ReleaseHeldInput();
+
+	float ThinkTimeRemaining = 0.f;
+	FGameplayTag HeldInputTag;
+};
@@ -15,15 +15,27 @@ class GAS_AURA_DEMO_API UAuraSummonAbility : public UAuraGameplayAbility
 	GENERATED_BODY()
 
 public:
+	//仅服务器：向 UAuraSummonSubsystem 登记召唤者，提前预加载召唤物的职业资源包
+	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
 
+	//在施法者前方扇形内取点，并一次性批量投影到导航网格
 	UFUNCTION(BlueprintCallable)
 	TArray<FVector> GetSpawnLocation();
+
+	//仅服务器：把召唤请求交给 UAuraSummonSubsystem 分帧生成，受每个召唤者的数量上限约束
+	UFUNCTION(BlueprintCallable, Category="Summoning")
+	void SpawnMinions();
+
+	//存活 + 排队中 的召唤物数量
+	UFUNCTION(BlueprintPure, Category="Summoning")
+	int32 GetNumActiveMinions() const;
 	
 	UPROPERTY(EditDefaultsOnly, Category="Summoning")
 	int32 NumMinion = 5;
 
+	//软引用：授予技能时才异步加载，召唤物蓝图不随施法者一起同步加载
 	UPROPERTY(EditDefaultsOnly, Category="Summoning")
-	TArray<TSubclassOf<APawn>> MinionClasses;
+	TArray<TSoftClassPtr<APawn>> MinionClasses;
 
 	UPROPERTY(EditDefaultsOnly, Category="Summoning")
 	float MinSpawnDistance = 50.f;
@@ -26,7 +26,17 @@ public:
 	void AbilityInputTagReleased(const FGameplayTag& InputTag);
 	
 protected:
+	//仅服务器：筛选出UI关心的标签（Message.*），同一帧内的通知合并为一次RPC
+	void EffectAppliedToSelf(UAbilitySystemComponent* AbilitySystemComponent,
+		const FGameplayEffectSpec& EffectSpec,FActiveGameplayEffectHandle ActiveEffectHandle);
+
+	void FlushPendingEffectAssetTags();
+
+	//标签以 GameplayTag 网络索引 传输
 	UFUNCTION(Client, reliable)
-	void ClientEffectApplied(UAbilitySystemComponent* AbilitySystemComponent,
-		const FGameplayEffectSpec& EffectSpec,FActiveGameplayEffectHandle ActiveEffectHandle) ;
+	void ClientEffectAssetTagsApplied(const TArray<uint16>& TagNetIndices);
+
+private:
+	TArray<uint16> PendingEffectAssetTagIndices;
+	bool bEffectAssetTagsFlushPending = false;
 };
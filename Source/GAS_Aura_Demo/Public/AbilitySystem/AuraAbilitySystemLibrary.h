@@ -10,6 +10,7 @@
 class UCharacterClassInfo;
 class UAbilitySystemComponent;
 enum class ECharacterClass : uint8;
+enum class EAuraTeam : uint8;
 class UAttributeMenuWidgetController;
 class UOverlayWidgetController;
 /**
@@ -57,8 +58,26 @@ public:
 	static void GetLivePlayerWithinRadius(const UObject* WorldContextObject, TArray<AActor*>& OutOverlappingActors, const TArray<AActor*>& ActorsToIgnore,
 	                                      float Radius, const FVector& SphereOrigin);
 
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static void GetLiveCombatantsInCone(const UObject* WorldContextObject, TArray<AActor*>& OutActors, const TArray<AActor*>& ActorsToIgnore,
+	                                    const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees);
+
+	//按距离由近到远返回最多 Count 个
+	UFUNCTION(BlueprintCallable, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static void GetNearestLiveCombatants(const UObject* WorldContextObject, TArray<AActor*>& OutActors, const TArray<AActor*>& ActorsToIgnore,
+	                                     const FVector& Origin, int32 Count, float MaxRadius);
+
 	UFUNCTION(Blueprintpure, Category="AuraAbilitySystemLibrary|GameplayMechanics")  
 	static bool IsNotFriend(AActor* FirstActor,AActor* SecondActor) ;
 
+	//未实现 ICombatInterface 的 Actor 视为中立
+	UFUNCTION(BlueprintPure, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static EAuraTeam GetActorTeam(const AActor* Actor);
+
+	UFUNCTION(BlueprintPure, Category="AuraAbilitySystemLibrary|GameplayMechanics")
+	static bool AreTeamsFriendly(EAuraTeam FirstTeam, EAuraTeam SecondTeam);
+
+	static ECollisionChannel GetProjectileChannelForTeam(EAuraTeam Team);
+
 	
 };
@@ -58,7 +58,19 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
+	virtual void PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const override;
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
 	virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data) override;
+	virtual void OnAttributeAggregatorCreated(const FGameplayAttribute& Attribute, FAggregator* NewAggregator) const override;
+
+	//角色等级变化后调用（仅服务器），标脏所有用到 Level 的派生属性
+	void MarkLevelDirty();
+
+	//立即按拓扑序重算已标脏的派生属性；平时每帧最多自动刷新一次
+	void FlushDerivedAttributes();
+
+	//初始化时在应用 Vital 效果前调用：输入可能从未变化（如主属性为 0、只依赖等级），全部标脏后立即重算
+	void RecomputeAllDerivedAttributes();
 
 	TMap<FGameplayTag, TStaticFuncPtr<FGameplayAttribute()>> TagsToAttributesMap;
 
@@ -203,6 +215,17 @@ public:
 	void OnRep_PhysicalResistance(const FGameplayAttributeData& OldPhysicalResistance) const;
 
 private:
+	void MarkAttributeDirty(const FGameplayAttribute& Attribute) const;
+	void MarkDerivedAttributesDirty(uint64 Formulas);
 	void SetEffectProperties(const struct FGameplayEffectModCallbackData& Data, FEffectProperties& Props) const;
 	void ShowFloatingText(const FEffectProperties& Props, float Damage, bool bIsBlockedHit, bool bIsCriticalHit) const;
+
+	/**
+	 * 派生属性依赖图：UAttributeFormulaInfo 中有公式的属性由这里维护，
+	 * 输入变化只标脏直接依赖它的公式，下游随结果变化继续标脏；位序即 GetFormulas() 的拓扑序
+	 */
+	uint64 DirtyDerivedAttributes = 0;
+	bool bDerivedAttributesFlushPending = false;
+	bool bFlushingDerivedAttributes = false;
+	bool bLevelChanged = false;
 };
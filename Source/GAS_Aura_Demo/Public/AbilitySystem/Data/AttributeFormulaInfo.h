@@ -0,0 +1,106 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "GameplayEffectTypes.h"
+#include "Engine/DataAsset.h"
+#include "AttributeFormulaInfo.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAuraAttributeFormula
+{
+	GENERATED_BODY()
+
+	//公式计算的属性，UMMC_AttributeFormula 按它查找公式
+	UPROPERTY(EditDefaultsOnly)
+	FGameplayAttribute Attribute;
+
+	//支持数字、+ - * /、括号、min(a, b)、max(a, b)，
+	//标识符为 UAuraAttributeSet 的属性名（可以是另一条公式的结果）或 Level（角色等级）
+	UPROPERTY(EditDefaultsOnly)
+	FString Expression;
+};
+
+/** 编译后的公式：逆波兰字节码，属性值按捕获槽位传入 */
+struct GAS_AURA_DEMO_API FAuraCompiledAttributeFormula
+{
+	static constexpr int32 MaxStackDepth = 16;
+	static constexpr int32 MaxCaptures = 16;
+
+	enum class EOp : uint8
+	{
+		Constant,
+		Capture,
+		Level,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Negate,
+		Min,
+		Max
+	};
+
+	struct FInstruction
+	{
+		EOp Op = EOp::Constant;
+		uint8 Slot = 0;
+		float Constant = 0.f;
+	};
+
+	FGameplayAttribute Attribute;
+	TArray<FInstruction> Code;
+	TArray<FGameplayEffectAttributeCaptureDefinition> Captures;
+	bool bUsesLevel = false;
+
+	//CapturedValues 与 Captures 一一对应
+	float Evaluate(const float* CapturedValues, float Level) const;
+};
+
+/**
+ * 派生属性公式表，加载时编译成字节码；类默认对象里带有 MaxHealth/MaxMana 的默认公式，
+ * 新建的资产会以此为初始值，未在 UAuraAssetManager 中配置资产时也直接使用类默认对象。
+ * 有公式的属性由 UAuraAttributeSet 的依赖图维护，公式按依赖关系排好拓扑序
+ */
+UCLASS()
+class GAS_AURA_DEMO_API UAttributeFormulaInfo : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//依赖图的脏标记用 uint64 位集
+	static constexpr int32 MaxFormulas = 64;
+
+	UAttributeFormulaInfo();
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	//未定义或编译失败时返回 nullptr
+	const FAuraCompiledAttributeFormula* FindFormula(const FGameplayAttribute& Attribute) const;
+
+	//按拓扑序排列：被引用的公式总在引用它的公式之前
+	TConstArrayView<FAuraCompiledAttributeFormula> GetFormulas() const { return CompiledFormulas; }
+
+	//直接用到该属性 / Level 的公式位集，位序即 GetFormulas() 的下标
+	uint64 GetDependentFormulas(const FGameplayAttribute& Attribute) const;
+	uint64 GetLevelDependentFormulas() const { return LevelDependentFormulas; }
+	uint64 GetAllFormulas() const { return CompiledFormulas.Num() >= MaxFormulas ? ~uint64(0) : (uint64(1) << CompiledFormulas.Num()) - 1; }
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	TArray<FAuraAttributeFormula> AttributeFormulas;
+
+private:
+	void CompileFormulas();
+	void SortFormulasByDependency();
+	void BuildDependentFormulas();
+
+	TArray<FAuraCompiledAttributeFormula> CompiledFormulas;
+	TMap<FGameplayAttribute, uint64> DependentFormulasByAttribute;
+	uint64 LevelDependentFormulas = 0;
+};
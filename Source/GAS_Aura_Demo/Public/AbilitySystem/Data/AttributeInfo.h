@@ -34,8 +34,23 @@ class GAS_AURA_DEMO_API UAttributeInfo : public UDataAsset
 	GENERATED_BODY()
 
 public:
-	FAuraAttributeInfo FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bNotFound = false) const;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	//找不到时返回一个空的默认信息
+	const FAuraAttributeInfo& FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bNotFound = false) const;
+
+	//返回 AttributeInformation 中的下标，找不到返回 INDEX_NONE
+	int32 FindAttributeInfoIndexForTag(const FGameplayTag& AttributeTag, bool bNotFound = false) const;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TArray<FAuraAttributeInfo> AttributeInformation;
+
+private:
+	//加载时建立 标签 -> 下标 的索引
+	void BuildAttributeIndex();
+
+	TMap<FGameplayTag, int32> AttributeIndexByTag;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayEffectExecutionCalculation.h"
+#include "Game/AuraCharacterClassSubsystem.h"
 #include "ExecCalc_Damage.generated.h"
 
 /**
@@ -19,4 +20,12 @@ public:
 
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams,
 	                                    FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
+
+private:
+	//找不到曲线时返回 nullptr
+	const FAuraDamageCoefficientCurves* GetCoefficientCurves(const UObject* WorldContextObject) const;
+
+	//执行都发生在 CDO 上：曲线表加载后查找一次，表被卸载后重新查找
+	mutable FAuraDamageCoefficientCurves CachedCoefficientCurves;
+	mutable TWeakObjectPtr<const UCurveTable> CachedCoefficientTable;
 };
@@ -0,0 +1,31 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayModMagnitudeCalculation.h"
+#include "MMC_AttributeFormula.generated.h"
+
+struct FAuraCompiledAttributeFormula;
+
+/**
+ * 通用 MMC：按 FormulaAttribute 在 UAttributeFormulaInfo 中查找编译好的公式求值，
+ * 捕获哪些属性也由公式决定；新增派生属性只需在资产里写公式，再建一个设置了 FormulaAttribute 的蓝图子类。
+ * 捕获均为快照，UAuraAttributeSet 上的公式属性之后由其依赖图维护
+ */
+UCLASS()
+class GAS_AURA_DEMO_API UMMC_AttributeFormula : public UGameplayModMagnitudeCalculation
+{
+	GENERATED_BODY()
+
+public:
+	virtual const TArray<FGameplayEffectAttributeCaptureDefinition>& GetAttributeCaptureDefinitions() const override;
+	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
+
+protected:
+	UPROPERTY(EditDefaultsOnly, Category="Formula")
+	FGameplayAttribute FormulaAttribute;
+
+private:
+	const FAuraCompiledAttributeFormula* FindFormula() const;
+};
@@ -3,20 +3,17 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "GameplayModMagnitudeCalculation.h"
+#include "AbilitySystem/ModMagCalc/MMC_AttributeFormula.h"
 #include "MMC_MaxHealth.generated.h"
 
 /**
- * 
+ * 公式见 UAttributeFormulaInfo 中的 MaxHealth，保留这个类是为了不改动已引用它的 GE 资产
  */
 UCLASS()
-class GAS_AURA_DEMO_API UMMC_MaxHealth : public UGameplayModMagnitudeCalculation
+class GAS_AURA_DEMO_API UMMC_MaxHealth : public UMMC_AttributeFormula
 {
 	GENERATED_BODY()
 
 public:
 	UMMC_MaxHealth();
-	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
-private:
-	FGameplayEffectAttributeCaptureDefinition VigorDef;
 };
@@ -3,21 +3,17 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "GameplayModMagnitudeCalculation.h"
+#include "AbilitySystem/ModMagCalc/MMC_AttributeFormula.h"
 #include "MMC_MaxMana.generated.h"
 
 /**
- * 
+ * 公式见 UAttributeFormulaInfo 中的 MaxMana，保留这个类是为了不改动已引用它的 GE 资产
  */
 UCLASS()
-class GAS_AURA_DEMO_API UMMC_MaxMana : public UGameplayModMagnitudeCalculation
+class GAS_AURA_DEMO_API UMMC_MaxMana : public UMMC_AttributeFormula
 {
 	GENERATED_BODY()
 
 public:
 	UMMC_MaxMana();
-	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
-
-private:
-	FGameplayEffectAttributeCaptureDefinition IntelligenceDef;
 };
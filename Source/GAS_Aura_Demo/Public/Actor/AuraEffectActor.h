@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "ActiveGameplayEffectHandle.h"
+#include "GameplayEffectTypes.h"
 #include "GameFramework/Actor.h"
 #include "AuraEffectActor.generated.h"
 
@@ -35,6 +36,9 @@ class GAS_AURA_DEMO_API AAuraEffectActor : public AActor
 	
 public:
 	AAuraEffectActor();
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
 
 protected:
 	virtual void BeginPlay() override;
@@ -47,6 +51,8 @@ protected:
 
 	UFUNCTION(BlueprintCallable)
 	void OnEndOverlap(AActor* TargetActor);
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	UPROPERTY(EditAnywhere,BlueprintReadOnly,Category="Applied Effects")
 	bool bDestroyOnEffectApplication = true;
@@ -71,8 +77,33 @@ protected:
 	UPROPERTY(EditAnywhere,BlueprintReadOnly,Category="Applied Effects")
 	EEffectRemovalPolicy InfiniteEffectRemovalPolicy=EEffectRemovalPolicy::RemoveOnEndOverlay;
 
-	TMap<FActiveGameplayEffectHandle,UAbilitySystemComponent*> ActiveEffectHandles;
+	//按目标索引，结束重叠时只移除该目标身上的句柄
+	TMultiMap<TWeakObjectPtr<UAbilitySystemComponent>,FActiveGameplayEffectHandle> ActiveEffectHandles;
 	
 	UPROPERTY(EditAnywhere,BlueprintReadOnly,Category="Applied Effects")
 	float ActorLevel=1.f;
+
+	/**
+	 * 区域效果（火池、治疗区等）：目标进入时施加一次，之后每个周期对区域内所有目标统一施加一次 AreaGameplayEffectClass，
+	 * 而不是每个目标各自触发；同一目标一个周期内最多施加一次，反复进出不会多算。效果必须为 Instant，只在服务器上生效。
+	 * 来源为发起者的 ASC，没有发起者时与 ApplyEffectToTarget 一样以目标自身为来源
+	 */
+	UPROPERTY(EditAnywhere,BlueprintReadOnly,Category="Area Effect")
+	TSubclassOf<UGameplayEffect> AreaGameplayEffectClass;
+	//第一个目标进入后开始计时，区域清空时停止
+	UPROPERTY(EditAnywhere,BlueprintReadOnly,Category="Area Effect",meta=(ClampMin="0.05"))
+	float AreaEffectPeriod=1.f;
+
+private:
+	void AddAreaOccupant(AActor* TargetActor);
+	void RemoveAreaOccupant(AActor* TargetActor);
+	void ApplyAreaEffect();
+	void ApplyAreaEffectToOccupants(TConstArrayView<TWeakObjectPtr<UAbilitySystemComponent>> Occupants);
+	FGameplayEffectSpecHandle MakeAreaEffectSpec(UAbilitySystemComponent* SourceASC) const;
+	bool IsAreaEffectInstant() const;
+
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> AreaOccupants;
+	//每个目标上次被施加区域效果的时间，离开区域后仍保留到满一个周期
+	TMap<TWeakObjectPtr<UAbilitySystemComponent>, double> AreaLastApplicationTimes;
+	FTimerHandle AreaEffectTimerHandle;
 };
@@ -0,0 +1,72 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystem/Data/CharacterClassInfo.h"
+#include "GameFramework/Actor.h"
+#include "AuraEnemySpawner.generated.h"
+
+class AAuraEnemy;
+class USphereComponent;
+struct FStreamableHandle;
+
+/**
+ * 仅服务器：关卡里代替直接摆放的敌人，敌人类是软引用，不随关卡一起同步加载。
+ * 玩家进入预加载范围时异步加载敌人类（在职业资源包里的引用整个包），进入激活范围后等类就绪再生成；
+ * 生成后的敌人自己持有资源包，刷怪点随即释放
+ */
+UCLASS()
+class GAS_AURA_DEMO_API AAuraEnemySpawner : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AAuraEnemySpawner();
+
+	//也可由关卡蓝图/触发器直接调用
+	UFUNCTION(BlueprintCallable, Category="Spawning")
+	void PreloadEnemyClasses();
+
+	UFUNCTION(BlueprintCallable, Category="Spawning")
+	void ActivateSpawner();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UFUNCTION()
+	void OnPreloadSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
+	                            int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UFUNCTION()
+	void OnActivationSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
+	                               int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<USphereComponent> PreloadSphere;
+
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<USphereComponent> ActivationSphere;
+
+	UPROPERTY(EditAnywhere, Category="Spawning")
+	TArray<TSoftClassPtr<AAuraEnemy>> EnemyClasses;
+
+	UPROPERTY(EditAnywhere, Category="Spawning")
+	int32 NumEnemies = 4;
+
+	UPROPERTY(EditAnywhere, Category="Spawning")
+	float SpawnRadius = 400.f;
+
+private:
+	void OnEnemyClassLoaded();
+	void SpawnEnemies();
+	void ReleaseEnemyClasses();
+
+	TArray<ECharacterClass> AcquiredClasses;
+	TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+	int32 NumPendingLoads = 0;
+	bool bPreloadRequested = false;
+	bool bActivated = false;
+	bool bSpawned = false;
+};
@@ -6,6 +6,7 @@
 #include "GameplayEffectTypes.h"
 #include "NiagaraSystem.h"
 #include "GameFramework/Actor.h"
+#include "Interaction/CombatInterface.h"
 #include "AuraProjectile.generated.h"
 
 class USphereComponent;
@@ -25,9 +26,14 @@ public:
 	UPROPERTY(BluePrintReadWrite,meta=(ExposeOnSpawn="true"))
 	FGameplayEffectSpecHandle DamageEffectSpecHandle;
 
+	//须在 FinishSpawning 之前设置，决定投射物的碰撞对象通道
+	void SetTeam(EAuraTeam InTeam);
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Destroyed() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	UFUNCTION()
 	void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
@@ -40,6 +46,9 @@ private:
 
 	bool bHit = false;
 
+	UPROPERTY(Replicated)
+	EAuraTeam Team = EAuraTeam::Neutral;
+
 	UPROPERTY(VisibleAnywhere)
 	TObjectPtr<USphereComponent> Sphere;
 
@@ -3,6 +3,8 @@
 #include "GameplayEffectTypes.h"
 #include"AuraAbilityTypes.generated.h"
 
+class ACharacter;
+
 
 USTRUCT(BlueprintType)
 struct FAuraGameplayEffectContext : public FGameplayEffectContext
@@ -38,7 +40,11 @@ public:
 	/** Custom serialization, subclasses must override this */
 	virtual bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess) override;
 
+	/** 只设置了 Location 的命中结果，按量化坐标传输 */
+	static bool IsHitResultLite(const FHitResult& Hit);
+
 protected:
+	//这两个值直接由 NetSerialize 的标志位携带
 	UPROPERTY()
 	bool bIsBlockedHit = false;
 
@@ -55,3 +61,33 @@ struct TStructOpsTypeTraits<FAuraGameplayEffectContext> : public TStructOpsTypeT
 		WithCopy = true // Necessary so that TSharedPtr<FHitResult> Data is copied around
 	};
 };
+
+/** 批量下发的伤害数字：目标以 NetGUID 传输，伤害量化到 0.1，格挡/暴击各占 1 位 */
+USTRUCT()
+struct FAuraDamageNumber
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<ACharacter> Target = nullptr;
+
+	UPROPERTY()
+	float Damage = 0.f;
+
+	UPROPERTY()
+	bool bIsBlockedHit = false;
+
+	UPROPERTY()
+	bool bIsCriticalHit = false;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FAuraDamageNumber> : public TStructOpsTypeTraitsBase2<FAuraDamageNumber>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
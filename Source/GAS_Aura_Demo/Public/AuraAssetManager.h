@@ -3,13 +3,31 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AbilitySystem/Data/CharacterClassInfo.h"
 #include "Engine/AssetManager.h"
 #include "AuraAssetManager.generated.h"
 
+class UAttributeFormulaInfo;
+struct FStreamableHandle;
+
+/** 一个职业的资源包：该职业所有敌人蓝图（连同其网格、蒙太奇、特效、音效等硬引用） */
+USTRUCT()
+struct FAuraCharacterClassBundle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	ECharacterClass CharacterClass = ECharacterClass::Warrior;
+
+	UPROPERTY()
+	TArray<TSoftClassPtr<APawn>> EnemyClasses;
+};
+
 /**
- * 
+ * 每个 ECharacterClass 注册为一个动态主资产（AuraCharacterClass:<职业名>），
+ * 敌人在场、召唤者获得召唤技能时按引用计数异步预加载对应资源包，全部释放后卸载，避免首次生成时同步加载卡顿
  */
-UCLASS()
+UCLASS(Config=Game)
 class GAS_AURA_DEMO_API UAuraAssetManager : public UAssetManager
 {
 	GENERATED_BODY()
@@ -17,6 +35,66 @@ class GAS_AURA_DEMO_API UAuraAssetManager : public UAssetManager
 public:
 	static UAuraAssetManager& Get();
 
+	static const FPrimaryAssetType CharacterClassAssetType;
+	static const FName CharacterClassBundleName;
+
+	static FPrimaryAssetId GetCharacterClassAssetId(ECharacterClass CharacterClass);
+
+	/** 引用计数 +1 并异步加载该职业的资源包；已加载时 OnLoaded 仍会被调用 */
+	TSharedPtr<FStreamableHandle> AcquireCharacterClass(ECharacterClass CharacterClass, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	/** 引用计数 -1，归零时卸载 */
+	void ReleaseCharacterClass(ECharacterClass CharacterClass);
+
+	/**
+	 * 异步请求一个软引用的敌人类：在某个职业资源包里时引用该资源包（OutAcquiredClass 返回职业，之后需 ReleaseCharacterClass），
+	 * 否则单独异步加载；调用方持有返回的句柄直到不再需要，OnLoaded 之后 TSoftClassPtr::Get 即可取到类
+	 */
+	TSharedPtr<FStreamableHandle> RequestEnemyClass(const FSoftObjectPath& EnemyClassPath, TOptional<ECharacterClass>& OutAcquiredClass,
+	                                                FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	bool IsCharacterClassLoaded(ECharacterClass CharacterClass) const;
+	//已请求、正在异步加载；没有配置资源包或加载被取消时为 false
+	bool IsCharacterClassLoading(ECharacterClass CharacterClass) const;
+
+	//供关卡蓝图/触发器在遭遇开始和结束时调用
+	UFUNCTION(BlueprintCallable, Category="Aura|Assets")
+	static void PreloadCharacterClass(ECharacterClass CharacterClass);
+
+	UFUNCTION(BlueprintCallable, Category="Aura|Assets")
+	static void ReleasePreloadedCharacterClass(ECharacterClass CharacterClass);
+
+	void LogCharacterClassBundles() const;
+
+	//未配置资产或资产管理器尚未就绪（如编辑器里打开 GE）时，退回到类默认对象中的默认公式
+	static const UAttributeFormulaInfo& GetAttributeFormulaInfo();
+
 protected:
 	virtual void StartInitialLoading() override;
+	virtual void PostInitialAssetScan() override;
+
+private:
+	struct FCharacterClassBundleState
+	{
+		int32 RefCount = 0;
+		int32 NumAssets = 0;
+		double RequestTime = 0.0;
+		double LoadMs = -1.0;
+	};
+
+	void OnCharacterClassLoaded(ECharacterClass CharacterClass);
+
+	UPROPERTY(Config)
+	TArray<FAuraCharacterClassBundle> CharacterClassBundles;
+
+	//派生属性公式在启动时同步加载并编译，之后 MMC 求值不再有加载或解析开销
+	UPROPERTY(Config)
+	TSoftObjectPtr<UAttributeFormulaInfo> AttributeFormulaInfoAsset;
+
+	UPROPERTY()
+	TObjectPtr<UAttributeFormulaInfo> AttributeFormulaInfo;
+
+	TMap<ECharacterClass, FCharacterClassBundleState> BundleStates;
+	int32 NumBundleLoads = 0;
+	int32 NumBundleUnloads = 0;
 };
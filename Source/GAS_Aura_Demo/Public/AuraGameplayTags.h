@@ -4,6 +4,113 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "Containers/StaticArray.h"
+
+/**
+ * 原生标签表：X(成员名, 标签名, 注释)。同一族的标签在 EAuraNativeTag 中连续，
+ * 新增标签只需在对应族里加一行，成员变量、枚举下标和注册代码都由它生成
+ */
+#define AURA_ATTRIBUTE_TAGS(X) \
+	X(Attributes_Primary_Strength, "Attributes.Primary.Strength", "增加物理伤害") \
+	X(Attributes_Primary_Intelligence, "Attributes.Primary.Intelligence", "增加魔法伤害和最大法力值") \
+	X(Attributes_Primary_Resilience, "Attributes.Primary.Resilience", "增加护甲与护甲穿透") \
+	X(Attributes_Primary_Vigor, "Attributes.Primary.Vigor", "增加最大生命值") \
+	X(Attributes_Secondary_Armor, "Attributes.Secondary.Armor", "减少受到的伤害，增加格挡概率") \
+	X(Attributes_Secondary_ArmorPenetration, "Attributes.Secondary.ArmorPenetration", "忽视敌人护甲，增加暴击概率") \
+	X(Attributes_Secondary_BlockChance, "Attributes.Secondary.BlockChance", "受到伤害减半（格挡）的概率") \
+	X(Attributes_Secondary_CriticalHitChance, "Attributes.Secondary.CriticalHitChance", "造成额外伤害（暴击）的概率") \
+	X(Attributes_Secondary_CriticalHitDamage, "Attributes.Secondary.CriticalHitDamage", "暴击时增加的额外伤害") \
+	X(Attributes_Secondary_CriticalHitResistance, "Attributes.Secondary.CriticalHitResistance", "减少敌人暴击的概率") \
+	X(Attributes_Secondary_HealthRegeneration, "Attributes.Secondary.HealthRegeneration", "每秒生命回复") \
+	X(Attributes_Secondary_ManaRegeneration, "Attributes.Secondary.ManaRegeneration", "每秒法力回复") \
+	X(Attributes_Secondary_MaxHealth, "Attributes.Secondary.MaxHealth", "可获得的生命值上限") \
+	X(Attributes_Secondary_MaxMana, "Attributes.Secondary.MaxMana", "可获得的最大法力值上限") \
+	X(Attributes_Resistance_Fire, "Attributes.Resistance.Fire", "火焰抗性") \
+	X(Attributes_Resistance_Lighting, "Attributes.Resistance.Lighting", "雷电抗性") \
+	X(Attributes_Resistance_Arcane, "Attributes.Resistance.Arcane", "奥术抗性") \
+	X(Attributes_Resistance_Physical, "Attributes.Resistance.Physical", "物理抗性")
+
+//伤害类型与抗性按族内下标一一对应，顺序必须和 Attributes_Resistance_* 一致
+#define AURA_DAMAGE_TAGS(X) \
+	X(Damage_Fire, "Damage.Fire", "火焰伤害类型") \
+	X(Damage_Lighting, "Damage.Lighting", "雷电伤害类型") \
+	X(Damage_Arcane, "Damage.Arcane", "奥术伤害类型") \
+	X(Damage_Physical, "Damage.Physical", "物理伤害类型")
+
+#define AURA_INPUT_TAGS(X) \
+	X(InputTag_LMB, "InputTag.LMB", "鼠标左键的输入标签") \
+	X(InputTag_RMB, "InputTag.RMB", "鼠标右键的输入标签") \
+	X(InputTag_1, "InputTag.1", "键盘 1 键的输入标签") \
+	X(InputTag_2, "InputTag.2", "键盘 2 键的输入标签") \
+	X(InputTag_3, "InputTag.3", "键盘 3 键的输入标签") \
+	X(InputTag_4, "InputTag.4", "键盘 4 键的输入标签")
+
+#define AURA_MONTAGE_TAGS(X) \
+	X(Montage_Attack_1, "Montage.Attack.1", "蒙太奇攻击动画 1") \
+	X(Montage_Attack_2, "Montage.Attack.2", "蒙太奇攻击动画 2") \
+	X(Montage_Attack_3, "Montage.Attack.3", "蒙太奇攻击动画 3") \
+	X(Montage_Attack_4, "Montage.Attack.4", "蒙太奇攻击动画 4")
+
+#define AURA_OTHER_TAGS(X) \
+	X(Damage, "Damage", "造成伤害") \
+	X(Abilities_Attack, "Abilities.Attack", "近战敌人的近战攻击") \
+	X(CombatSocket_Weapon, "CombatSocket.Weapon", "武器战斗插槽") \
+	X(CombatSocket_LeftHand, "CombatSocket.LeftHand", "左手战斗插槽") \
+	X(CombatSocket_RightHand, "CombatSocket.RightHand", "右手战斗插槽") \
+	X(CombatSocket_Tail, "CombatSocket.Tail", "尾巴战斗插槽") \
+	X(Effects_HitReact, "Effects.HitReact", "受击反应时赋予标签") \
+	X(Message, "Message", "UI消息的父标签，只有带此类标签的效果才会通知客户端")
+
+#define AURA_NATIVE_GAMEPLAY_TAGS(X) \
+	AURA_ATTRIBUTE_TAGS(X) \
+	AURA_DAMAGE_TAGS(X) \
+	AURA_INPUT_TAGS(X) \
+	AURA_MONTAGE_TAGS(X) \
+	AURA_OTHER_TAGS(X)
+
+#define AURA_NATIVE_TAG_ENUM(Member, TagName, Comment) Member,
+#define AURA_NATIVE_TAG_COUNT(Member, TagName, Comment) +1
+
+/** 原生标签的稠密下标，可直接 switch 或作为数组下标 */
+enum class EAuraNativeTag : uint8
+{
+	AURA_NATIVE_GAMEPLAY_TAGS(AURA_NATIVE_TAG_ENUM)
+	Count,
+	None = 0xFF
+};
+
+/** 一族连续的原生标签：族内下标与定长数组 */
+template <uint8 InBegin, uint8 InEnd>
+struct TAuraNativeTagFamily
+{
+	static constexpr int32 Num = InEnd - InBegin;
+	static_assert(Num > 0, "Empty native tag family");
+
+	static constexpr bool Contains(EAuraNativeTag Tag)
+	{
+		return static_cast<uint8>(Tag) >= InBegin && static_cast<uint8>(Tag) < InEnd;
+	}
+
+	static constexpr int32 ToLocal(EAuraNativeTag Tag) { return static_cast<uint8>(Tag) - InBegin; }
+	static constexpr EAuraNativeTag FromLocal(int32 LocalIndex) { return static_cast<EAuraNativeTag>(InBegin + LocalIndex); }
+
+	template <typename ValueType>
+	using TValues = TStaticArray<ValueType, Num>;
+};
+
+namespace AuraNativeTagRange
+{
+	constexpr uint8 AttributesBegin = 0;
+	constexpr uint8 AttributesEnd = AttributesBegin AURA_ATTRIBUTE_TAGS(AURA_NATIVE_TAG_COUNT);
+	constexpr uint8 DamageTypesEnd = AttributesEnd AURA_DAMAGE_TAGS(AURA_NATIVE_TAG_COUNT);
+	constexpr uint8 InputsEnd = DamageTypesEnd AURA_INPUT_TAGS(AURA_NATIVE_TAG_COUNT);
+	constexpr uint8 MontagesEnd = InputsEnd AURA_MONTAGE_TAGS(AURA_NATIVE_TAG_COUNT);
+}
+
+using FAuraAttributeTags = TAuraNativeTagFamily<AuraNativeTagRange::AttributesBegin, AuraNativeTagRange::AttributesEnd>;
+using FAuraDamageTypeTags = TAuraNativeTagFamily<AuraNativeTagRange::AttributesEnd, AuraNativeTagRange::DamageTypesEnd>;
+using FAuraInputTags = TAuraNativeTagFamily<AuraNativeTagRange::DamageTypesEnd, AuraNativeTagRange::InputsEnd>;
+using FAuraMontageTags = TAuraNativeTagFamily<AuraNativeTagRange::InputsEnd, AuraNativeTagRange::MontagesEnd>;
 
 /**
  * Singleton containing native Gameplay Tags
@@ -15,59 +122,38 @@ public:
 	static const FAuraGameplayTags& Get() { return GameplayTags; }
 	static void InitializeNativeGameplayTags();
 
-	FGameplayTag Attributes_Primary_Strength;
-	FGameplayTag Attributes_Primary_Intelligence;
-	FGameplayTag Attributes_Primary_Resilience;
-	FGameplayTag Attributes_Primary_Vigor;
-
-	FGameplayTag Attributes_Secondary_Armor;
-	FGameplayTag Attributes_Secondary_ArmorPenetration;
-	FGameplayTag Attributes_Secondary_BlockChance;
-	FGameplayTag Attributes_Secondary_CriticalHitChance;
-	FGameplayTag Attributes_Secondary_CriticalHitDamage;
-	FGameplayTag Attributes_Secondary_CriticalHitResistance;
-	FGameplayTag Attributes_Secondary_HealthRegeneration;
-	FGameplayTag Attributes_Secondary_ManaRegeneration;
-	FGameplayTag Attributes_Secondary_MaxHealth;
-	FGameplayTag Attributes_Secondary_MaxMana;
-
-	//实际上也是次级属性
-	FGameplayTag Attributes_Resistance_Fire;
-	FGameplayTag Attributes_Resistance_Lighting;
-	FGameplayTag Attributes_Resistance_Arcane;
-	FGameplayTag Attributes_Resistance_Physical; 
-
-	FGameplayTag InputTag_LMB;
-	FGameplayTag InputTag_RMB;
-	FGameplayTag InputTag_1;
-	FGameplayTag InputTag_2;
-	FGameplayTag InputTag_3;
-	FGameplayTag InputTag_4;
-
-	FGameplayTag Damage;
-	FGameplayTag Damage_Fire;
-	FGameplayTag Damage_Lighting;
-	FGameplayTag Damage_Arcane;
-	FGameplayTag Damage_Physical;
-
-	FGameplayTag Abilities_Attack;
-
-	//战斗插槽
-	FGameplayTag CombatSocket_Weapon;
-	FGameplayTag CombatSocket_LeftHand;
-	FGameplayTag CombatSocket_RightHand;
-	FGameplayTag CombatSocket_Tail;
-
-	//蒙太奇动画
-	FGameplayTag Montage_Attack_1;
-	FGameplayTag Montage_Attack_2;
-	FGameplayTag Montage_Attack_3;
-	FGameplayTag Montage_Attack_4;
-	
-	TMap<FGameplayTag,FGameplayTag> DamageTypesToResistances;
-
-	FGameplayTag Effects_HitReact;
+#define AURA_NATIVE_TAG_MEMBER(Member, TagName, Comment) FGameplayTag Member;
+	AURA_NATIVE_GAMEPLAY_TAGS(AURA_NATIVE_TAG_MEMBER)
+#undef AURA_NATIVE_TAG_MEMBER
+
+	const FGameplayTag& GetTag(EAuraNativeTag Tag) const { return TagsByIndex[static_cast<uint8>(Tag)]; }
+
+	//非原生标签返回 None；按 FName 开放寻址查表，不走标签树
+	EAuraNativeTag IndexOf(const FGameplayTag& Tag) const;
+
+	static constexpr EAuraNativeTag GetResistanceForDamageType(EAuraNativeTag DamageType)
+	{
+		return static_cast<EAuraNativeTag>(AuraNativeTagRange::AttributesEnd - FAuraDamageTypeTags::Num + FAuraDamageTypeTags::ToLocal(DamageType));
+	}
 
 private:
 	static FAuraGameplayTags GameplayTags;
+
+	static constexpr int32 IndexTableSize = 128;
+	static_assert(IndexTableSize >= static_cast<int32>(EAuraNativeTag::Count) * 2, "Grow IndexTableSize with the tag list");
+
+	struct FIndexSlot
+	{
+		FName TagName;
+		EAuraNativeTag Index = EAuraNativeTag::None;
+	};
+
+	void AddToIndex(EAuraNativeTag Index, const FGameplayTag& Tag);
+
+	TStaticArray<FGameplayTag, static_cast<uint8>(EAuraNativeTag::Count)> TagsByIndex;
+	TStaticArray<FIndexSlot, IndexTableSize> IndexTable;
 };
+
+static_assert(FAuraGameplayTags::GetResistanceForDamageType(EAuraNativeTag::Damage_Fire) == EAuraNativeTag::Attributes_Resistance_Fire &&
+              FAuraGameplayTags::GetResistanceForDamageType(EAuraNativeTag::Damage_Physical) == EAuraNativeTag::Attributes_Resistance_Physical,
+              "Damage types must map one-to-one onto the trailing Attributes_Resistance_* tags");
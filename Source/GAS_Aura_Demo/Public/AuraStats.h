@@ -0,0 +1,78 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/**
+ * 战斗相关的性能统计：stat AuraCombat 查看，Insights 中用 -trace=cpu,AuraCombat 采集，
+ * 统计关闭的构建（Test/Shipping）里 trace 通道仍然可用；
+ * CSV 按 AI/投射物/GAS/UI/网络 分类记录每帧的独占耗时，用 Tools/Perf/csv_budget_report.py 检查预算
+ */
+DECLARE_STATS_GROUP(TEXT("AuraCombat"), STATGROUP_AuraCombat, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ExecCalc Damage"), STAT_AuraExecCalcDamage, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("MMC AttributeFormula"), STAT_AuraMMCAttributeFormula, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Derived Attributes Flush"), STAT_AuraDerivedAttributesFlush, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PostGameplayEffectExecute"), STAT_AuraPostGameplayEffectExecute, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SpawnProjectile"), STAT_AuraSpawnProjectile, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile OnSphereOverlap"), STAT_AuraProjectileOverlap, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Area Effect Pulse"), STAT_AuraAreaEffectPulse, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CursorTrace"), STAT_AuraCursorTrace, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AutoRun"), STAT_AuraAutoRun, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("WidgetController Broadcast"), STAT_AuraWidgetControllerBroadcast, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Show Damage Numbers"), STAT_AuraShowDamageNumbers, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flush Damage Numbers"), STAT_AuraFlushDamageNumbers, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BehaviorTree Tick"), STAT_AuraBehaviorTreeTick, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI LOD Evaluate"), STAT_AuraAILODEvaluate, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Effects Applied"), STAT_AuraEffectsApplied, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Projectiles Alive"), STAT_AuraProjectilesAlive, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Numbers Spawned"), STAT_AuraDamageNumbersSpawned, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Derived Attributes Recomputed"), STAT_AuraDerivedAttributesRecomputed, STATGROUP_AuraCombat, GAS_AURA_DEMO_API);
+
+UE_TRACE_CHANNEL_EXTERN(AuraCombatChannel, GAS_AURA_DEMO_API);
+
+//AuraCombat 只放计数器；耗时走 Exclusive 分类，列名为 Exclusive/<线程>/<AuraAI|AuraGAS|...>/<Stat>
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(GAS_AURA_DEMO_API, AuraCombat);
+
+//LLM 内存标签：-llm 启动后在 stat LLMFULL / Insights 内存视图中按 Aura/* 分组，名字里的 _ 对应层级 /
+LLM_DECLARE_TAG_API(Aura, GAS_AURA_DEMO_API);
+LLM_DECLARE_TAG_API(Aura_Enemies, GAS_AURA_DEMO_API);
+LLM_DECLARE_TAG_API(Aura_Players, GAS_AURA_DEMO_API);
+LLM_DECLARE_TAG_API(Aura_AbilitySystem, GAS_AURA_DEMO_API);
+LLM_DECLARE_TAG_API(Aura_AI, GAS_AURA_DEMO_API);
+LLM_DECLARE_TAG_API(Aura_UI, GAS_AURA_DEMO_API);
+LLM_DECLARE_TAG_API(Aura_Projectiles, GAS_AURA_DEMO_API);
+LLM_DECLARE_TAG_API(Aura_Subsystems, GAS_AURA_DEMO_API);
+
+//CSV 独占计时：嵌套的内层作用域（包括引擎自己的独占作用域）从外层扣除，各分类相加不会重复计入同一段时间
+#if CSV_PROFILER
+#define AURA_CSV_EXCLUSIVE_SCOPE(CsvCategory, Stat) \
+	FScopedCsvStatExclusive PREPROCESSOR_JOIN(AuraCsvExclusive_, __LINE__)(#CsvCategory "/" #Stat)
+#else
+#define AURA_CSV_EXCLUSIVE_SCOPE(CsvCategory, Stat)
+#endif
+
+//同时计入 stat、CSV 独占计时 和 AuraCombat trace 通道
+#define AURA_COMBAT_SCOPE(Stat, CsvCategory) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	AURA_CSV_EXCLUSIVE_SCOPE(CsvCategory, Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, AuraCombatChannel)
+
+namespace AuraStats
+{
+	GAS_AURA_DEMO_API void EffectApplied();
+	GAS_AURA_DEMO_API void ProjectileSpawned();
+	GAS_AURA_DEMO_API void ProjectileDestroyed();
+	GAS_AURA_DEMO_API void DamageNumberSpawned();
+	GAS_AURA_DEMO_API void DerivedAttributesRecomputed(int32 NumAttributes);
+	GAS_AURA_DEMO_API int32 GetNumProjectilesAlive();
+	//进程内累计生成的投射物数量
+	GAS_AURA_DEMO_API int32 GetNumProjectilesSpawned();
+}
@@ -34,16 +34,20 @@ public:
 	virtual TArray<FTaggedMontage> GetAttackMontages_Implementation() override;
 	virtual UNiagaraSystem* GetBloodEffect_Implementation() override;
 	virtual FTaggedMontage GetTaggedMontageByTag_Implementation(const FGameplayTag& MontageTag) override;
+	virtual EAuraTeam GetTeam() const override { return Team; }
 	/** Combat Interface */
 
-	UFUNCTION(NetMulticast, reliable)
-	virtual void MulticastHandleDeath();
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	//仅服务器：对象池复用时撤销死亡状态，客户端通过 OnRep_Dead 同步
+	virtual void ResetDeathState();
 
 	UPROPERTY(EditAnywhere, Category="Combat")
 	TArray<FTaggedMontage> AttackMontages;
 	
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	UPROPERTY(EditAnywhere,BlueprintReadOnly, Category="Combat")
 	TObjectPtr<USkeletalMeshComponent> Weapon;
@@ -57,7 +61,24 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Combat")
 	FName TailSocketName;
 
+	//死亡以复制状态表达，客户端（包括之后才进入相关范围的）在 OnRep 里幂等地表现死亡
+	UPROPERTY(ReplicatedUsing=OnRep_Dead)
 	bool bDead=false;
+
+	//服务器时间，客户端据此判断是否还需要播放死亡音效
+	UPROPERTY(Replicated)
+	float DeathTime=0.f;
+
+	UFUNCTION()
+	void OnRep_Dead();
+
+	//布娃娃、音效、溶解，重复调用无副作用
+	virtual void HandleDeath();
+	void HandleDeathStateReset();
+
+	//阵营决定敌我判断和网格体忽略哪条投射物通道
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Combat")
+	EAuraTeam Team = EAuraTeam::Neutral;
 	
 	UPROPERTY()
 	TObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
@@ -110,4 +131,21 @@ private:
 
 	UPROPERTY(EditAnywhere, Category="Combat")
 	TObjectPtr<UAnimMontage> HitReactMontage;
+
+	FTransform DefaultMeshRelativeTransform;
+	FTransform DefaultWeaponRelativeTransform;
+	TEnumAsByte<ECollisionResponse> DefaultMeshWorldStaticResponse = ECR_Block;
+	bool bDefaultMeshEnableGravity = true;
+	bool bDefaultWeaponEnableGravity = true;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialInterface> DefaultMeshMaterial;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialInterface> DefaultWeaponMaterial;
+
+	bool bDeathHandled = false;
+
+	//死亡超过这个时间才同步到的客户端不再播放音效
+	static constexpr float DeathSoundMaxDelay = 1.f;
 };
@@ -6,6 +6,7 @@
 #include "AbilitySystem/Data/CharacterClassInfo.h"
 #include "Character/AuraCharacterBase.h"
 #include "Interaction/EnemyInterface.h"
+#include "Game/AuraSignificanceSubsystem.h"
 #include "UI/WidgetController/OverlayWidgetController.h"
 #include "AuraEnemy.generated.h"
 
@@ -45,6 +46,12 @@ public:
 
 	void HitReactTagChanged(const FGameplayTag CallbackTag, int32 NewCount);
 
+	//由 UAuraSignificanceSubsystem 在档位变化时调用
+	void SetSignificanceBucket(EAuraSignificanceBucket Bucket, const FAuraSignificanceBucketSettings& Settings);
+	EAuraSignificanceBucket GetSignificanceBucket() const { return SignificanceBucket; }
+
+	ECharacterClass GetCharacterClass() const { return CharacterClass; }
+
 	UPROPERTY(BlueprintReadOnly, Category="Combat")
 	bool bHitReacting = false;
 
@@ -57,9 +64,16 @@ public:
 	
 	UPROPERTY(BlueprintReadWrite, Category="Combat")
 	TObjectPtr<AActor> CombatTarget;
+
+	//由 UAuraSummonSubsystem 生成的召唤物，死亡后回收到对象池而不是销毁
+	bool bPooledMinion = false;
+
+	void DeactivateForPool();
+	void ReactivateFromPool(const FVector& Location, const FRotator& Rotation);
 	
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void InitAbilityActorInfo() override;
 	virtual void InitializeDefaultAttributes() const override;
 
@@ -77,4 +91,15 @@ protected:
 	
 	UPROPERTY(EditAnywhere, Category="AI")
 	TObjectPtr<UBehaviorTree> BehaviorTree;
+
+private:
+	void ReleaseToPool();
+	void ApplySignificanceSettings(const FAuraSignificanceBucketSettings& Settings);
+
+	FTimerHandle PoolReleaseTimer;
+
+	EAuraSignificanceBucket SignificanceBucket = EAuraSignificanceBucket::High;
+	float BaseNetUpdateFrequency = 0.f;
+
+	bool bAcquiredCharacterClass = false;
 };
@@ -0,0 +1,49 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "AuraCharacterClassSubsystem.generated.h"
+
+class UCharacterClassInfo;
+struct FRealCurve;
+
+/** 伤害计算用到的系数曲线，加载时查找一次 */
+struct FAuraDamageCoefficientCurves
+{
+	const FRealCurve* ArmorPenetration = nullptr;
+	const FRealCurve* EffectiveArmor = nullptr;
+	const FRealCurve* CriticalHitResistance = nullptr;
+
+	bool IsValid() const { return ArmorPenetration && EffectiveArmor && CriticalHitResistance; }
+};
+
+/**
+ * 持有预加载的角色职业信息，服务器和客户端都可用（GameMode 只存在于服务器）
+ */
+UCLASS(Config=Game)
+class GAS_AURA_DEMO_API UAuraCharacterClassSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UAuraCharacterClassSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	UCharacterClassInfo* GetCharacterClassInfo() const { return CharacterClassInfo; }
+	const FAuraDamageCoefficientCurves& GetDamageCoefficientCurves() const { return DamageCoefficientCurves; }
+
+	//未配置资产时，由服务器的 GameMode 补上
+	void SetCharacterClassInfo(UCharacterClassInfo* InCharacterClassInfo);
+
+private:
+	UPROPERTY(Config)
+	TSoftObjectPtr<UCharacterClassInfo> CharacterClassInfoAsset;
+
+	UPROPERTY()
+	TObjectPtr<UCharacterClassInfo> CharacterClassInfo;
+
+	FAuraDamageCoefficientCurves DamageCoefficientCurves;
+};
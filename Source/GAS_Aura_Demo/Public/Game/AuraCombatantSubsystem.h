@@ -0,0 +1,143 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interaction/CombatInterface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraCombatantSubsystem.generated.h"
+
+/**
+ * 均匀网格空间索引：只按 XY 平面分格，元素用整数 Id 标识，不依赖物理场景
+ */
+struct GAS_AURA_DEMO_API FAuraSpatialGrid
+{
+	explicit FAuraSpatialGrid(float InCellSize = 500.f) : CellSize(InCellSize) {}
+
+	void Add(int32 Id, const FVector& Location, float Radius = 0.f);
+	void Remove(int32 Id);
+
+	//仍在同一格子内时只更新坐标，跨格子才移动桶
+	void Move(int32 Id, const FVector& NewLocation);
+
+	bool Contains(int32 Id) const { return Items.IsValidIndex(Id) && Items[Id].bValid; }
+	const FVector& GetLocation(int32 Id) const { return Items[Id].Location; }
+
+	/** 对所有与球体相交（考虑元素自身半径）的元素调用 Func(Id, DistSquared) */
+	template <typename FuncType>
+	void ForEachInRadius(const FVector& Origin, float Radius, FuncType&& Func) const;
+
+private:
+	struct FItem
+	{
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		float Radius = 0.f;
+		bool bValid = false;
+	};
+
+	FIntPoint ToCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+	}
+
+	float CellSize;
+	float MaxItemRadius = 0.f;
+	TArray<FItem> Items;
+	TMap<FIntPoint, TArray<int32>> Cells;
+};
+
+template <typename FuncType>
+void FAuraSpatialGrid::ForEachInRadius(const FVector& Origin, float Radius, FuncType&& Func) const
+{
+	//格子范围按 查询半径+最大元素半径 扩展，保证压在格子边缘的元素不会漏掉
+	const float SearchRadius = Radius + MaxItemRadius;
+	const FIntPoint MinCell = ToCell(Origin - FVector(SearchRadius, SearchRadius, 0.f));
+	const FIntPoint MaxCell = ToCell(Origin + FVector(SearchRadius, SearchRadius, 0.f));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<int32>* Bucket = Cells.Find(FIntPoint(X, Y));
+			if (Bucket == nullptr) continue;
+
+			for (const int32 Id : *Bucket)
+			{
+				const FItem& Item = Items[Id];
+				const float DistSquared = FVector::DistSquared(Origin, Item.Location);
+				const float Reach = Radius + Item.Radius;
+				if (DistSquared <= Reach * Reach)
+				{
+					Func(Id, DistSquared);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * 记录世界中所有实现 ICombatInterface 的角色，按网格索引位置并缓存存活状态与阵营，
+ * 半径/锥形/最近K个 查询都不走物理 Overlap
+ */
+UCLASS()
+class GAS_AURA_DEMO_API UAuraCombatantSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UAuraCombatantSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCombatant(AActor* Combatant);
+	void UnregisterCombatant(AActor* Combatant);
+	void SetCombatantDead(AActor* Combatant, bool bDead);
+
+	/** 以下查询只返回存活的战斗者 */
+	void GetLiveCombatantsInRadius(const FVector& Origin, float Radius, const TArray<AActor*>& ActorsToIgnore,
+	                               TArray<AActor*>& OutActors) const;
+
+	void GetLiveCombatantsInCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees,
+	                             const TArray<AActor*>& ActorsToIgnore, TArray<AActor*>& OutActors) const;
+
+	//按距离由近到远
+	void GetNearestLiveCombatants(const FVector& Origin, int32 Count, float MaxRadius,
+	                              const TArray<AActor*>& ActorsToIgnore, TArray<AActor*>& OutActors) const;
+
+	void GetLiveCombatants(TArray<AActor*>& OutActors) const;
+
+	//服务器上的 AI LOD 和重要度以存活的玩家阵营战斗者作为视点，不依赖 PlayerController，无头压力测试里的 AI 替身也算在内
+	void GetLiveCombatantLocations(EAuraTeam Team, TArray<FVector>& OutLocations) const;
+
+	int32 GetNumCombatants() const { return Combatants.Num(); }
+
+private:
+	struct FCombatantEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TObjectKey<AActor> Key;
+		TWeakObjectPtr<USceneComponent> Root;
+		FDelegateHandle TransformUpdatedHandle;
+		EAuraTeam Team = EAuraTeam::Neutral;
+		bool bDead = false;
+		bool bMoved = false;
+	};
+
+	//根组件变换更新时记下 Id，Tick 里只把这些角色写回网格
+	void HandleCombatantMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+	                          ETeleportType Teleport, int32 Id);
+	void MarkMoved(int32 Id);
+
+	bool IsQueryCandidate(int32 Id, const TArray<AActor*>& ActorsToIgnore) const;
+
+	//存活敌人/玩家、激活中的效果、存活投射物，CSV 采集时每帧写入 AuraCombat 分类
+	void RecordCsvCounters() const;
+
+	TSparseArray<FCombatantEntry> Combatants;
+	TMap<TObjectKey<AActor>, int32> CombatantIds;
+	TArray<int32> MovedIds;
+	FAuraSpatialGrid Grid;
+};
@@ -0,0 +1,44 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraLoadTestSubsystem.generated.h"
+
+class UNetDriver;
+
+/**
+ * 压测用，仅在命令行带 -AuraLoadTestCSV=<路径> 时创建：服务器按采样间隔把帧时间、
+ * 每个连接的带宽/包数/RPC 次数追加写入 CSV，-AuraLoadTestDuration=<秒> 到时自动退出
+ */
+UCLASS(Config=Game)
+class GAS_AURA_DEMO_API UAuraLoadTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void WriteSample(UNetDriver* NetDriver);
+
+	UPROPERTY(Config)
+	float SampleInterval = 1.f;
+
+	TUniquePtr<FArchive> CsvWriter;
+	double StartTime = 0.0;
+	double Duration = 0.0;
+
+	float SampleElapsed = 0.f;
+	int32 SampleFrames = 0;
+	double FrameMsSum = 0.0;
+	double FrameMsMax = 0.0;
+	double GameThreadMsSum = 0.0;
+	double GameThreadMsMax = 0.0;
+};
@@ -0,0 +1,32 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 存活战斗者的内存占用：角色、控制器、PlayerState、ASC/属性集、血条控件及其全部子对象，
+ * 按最近的 组件/属性集/控件/Actor 的原生类名分组。口径与 obj list 一致（属性内存 + 独占资源内存），
+ * 行为树实例内存等非 UPROPERTY 分配不在其中，完整数据用 -llm 看 Aura/* 标签。
+ * 控制台 Aura.Memory.Combatants 输出报表，压力测试用它检查每个敌人的预算
+ */
+struct GAS_AURA_DEMO_API FAuraCombatantMemoryReport
+{
+	struct FClassEntry
+	{
+		int32 NumCombatants = 0;
+		uint64 TotalBytes = 0;
+		TMap<FName, uint64> BytesByType;
+	};
+
+	//按战斗者的类名分组
+	TMap<FName, FClassEntry> Classes;
+	int32 NumEnemies = 0;
+	uint64 EnemyBytes = 0;
+
+	static FAuraCombatantMemoryReport Gather(const UObject* WorldContextObject);
+	static void MeasureCombatant(AActor* Combatant, TMap<FName, uint64>& OutBytesByType);
+
+	uint64 GetAverageEnemyBytes() const { return NumEnemies > 0 ? EnemyBytes / NumEnemies : 0; }
+	void Log() const;
+};
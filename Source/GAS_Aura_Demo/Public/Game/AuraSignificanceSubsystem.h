@@ -0,0 +1,87 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraSignificanceSubsystem.generated.h"
+
+class AAuraEnemy;
+
+DECLARE_STATS_GROUP(TEXT("AuraSignificance"), STATGROUP_AuraSignificance, STATCAT_Advanced);
+
+UENUM()
+enum class EAuraSignificanceBucket : uint8
+{
+	High,
+	Medium,
+	Low,
+	Dormant, //超出投射物射程，客户端上网格体不再产生重叠
+	MAX UMETA(Hidden)
+};
+
+USTRUCT()
+struct FAuraSignificanceBucketSettings
+{
+	GENERATED_BODY()
+
+	//离最近视点的距离不超过该值时进入本档
+	UPROPERTY(EditDefaultsOnly)
+	float MaxDistance = 0.f;
+
+	UPROPERTY(EditDefaultsOnly)
+	float MeshTickInterval = 0.f;
+
+	//移动和重叠在服务器上是玩法逻辑，这两项只在客户端生效
+	UPROPERTY(EditDefaultsOnly)
+	float MovementTickInterval = 0.f;
+
+	UPROPERTY(EditDefaultsOnly)
+	bool bMeshGenerateOverlapEvents = true;
+
+	UPROPERTY(EditDefaultsOnly)
+	bool bHealthBarTick = true;
+
+	//相对敌人默认 NetUpdateFrequency 的倍率，仅服务器生效
+	UPROPERTY(EditDefaultsOnly)
+	float NetUpdateFrequencyScale = 1.f;
+};
+
+/**
+ * 每帧把所有玩家视点交给 SignificanceManager，按距离给敌人分档并调整各项开销；
+ * 可见性只在客户端参与分档，服务器只按到所有玩家视点的距离分档，且只调整动画、控件和同步频率
+ */
+UCLASS(Config=Game)
+class GAS_AURA_DEMO_API UAuraSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UAuraSignificanceSubsystem();
+
+	static UAuraSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterEnemy(AAuraEnemy* Enemy);
+	void UnregisterEnemy(AAuraEnemy* Enemy);
+
+	const FAuraSignificanceBucketSettings& GetBucketSettings(EAuraSignificanceBucket Bucket) const;
+
+private:
+	EAuraSignificanceBucket CalculateBucket(const AAuraEnemy* Enemy, const FTransform& Viewpoint) const;
+	void OnBucketChanged(AAuraEnemy* Enemy, EAuraSignificanceBucket OldBucket, EAuraSignificanceBucket NewBucket);
+
+	//按 EAuraSignificanceBucket 顺序排列
+	UPROPERTY(Config)
+	TArray<FAuraSignificanceBucketSettings> BucketSettings;
+
+	//客户端上未被渲染的敌人至少降到该档
+	UPROPERTY(Config)
+	EAuraSignificanceBucket NotRenderedBucket = EAuraSignificanceBucket::Low;
+
+	TArray<FTransform> Viewpoints;
+	int32 BucketCounts[static_cast<uint8>(EAuraSignificanceBucket::MAX)] = {};
+};
@@ -0,0 +1,140 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystem/Data/CharacterClassInfo.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraStressTestSubsystem.generated.h"
+
+class AAuraCharacter;
+class AAuraEnemy;
+class AAuraStandInAIController;
+
+USTRUCT()
+struct FAuraStressTestEnemySpawn
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	ECharacterClass CharacterClass = ECharacterClass::Warrior;
+
+	UPROPERTY()
+	TSoftClassPtr<AAuraEnemy> EnemyClass;
+
+	//命令行 -AuraStressEnemies<职业名>=<数量> 可覆盖，例如 -AuraStressEnemiesRanger=20
+	UPROPERTY()
+	int32 Count = 10;
+};
+
+/**
+ * 无头压力测试，仅在命令行带 -AuraStressTest 时创建（配合 -server 或 -game -nullrhi）：
+ * 按职业生成敌人、生成 AI 替身玩家让双方持续交战，死亡的一方会补满；
+ * 替身是玩家阵营的战斗者，AI LOD 和重要度在服务器上以它们作为视点，敌人不会因为没有 PlayerController 全部降到最低档；
+ * 预热后统计服务器每帧耗时（不含限帧等待）的平均值/P99、内存增长以及每个敌人的内存占用，
+ * 测量期间必须有投射物生成且有敌人阵亡，否则视为没有真正交战；
+ * 结果写成 JSON 并以退出码 0/1 表示是否在预算内
+ */
+UCLASS(Config=Game)
+class GAS_AURA_DEMO_API UAuraStressTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	enum class EPhase : uint8
+	{
+		Idle,
+		Warmup,
+		Measure,
+		Done
+	};
+
+	void OnCharacterClassLoaded();
+	void StartWarmup();
+	void TopUp();
+	void PruneDeadEnemies();
+	void SpawnStandIn();
+	void SpawnEnemy(int32 SpawnIndex);
+	bool FindSpawnLocation(FVector& OutLocation) const;
+	void Finish();
+
+	void OnWorldTickStart(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds);
+	void OnEndFrame();
+
+	UPROPERTY(Config)
+	TArray<FAuraStressTestEnemySpawn> EnemySpawns;
+
+	UPROPERTY(Config)
+	TSoftClassPtr<AAuraCharacter> StandInClass;
+
+	//以下均可用同名命令行参数覆盖，例如 -AuraStressDuration=120
+	UPROPERTY(Config)
+	int32 NumStandIns = 4;
+
+	UPROPERTY(Config)
+	float SpawnRadius = 2500.f;
+
+	UPROPERTY(Config)
+	float WarmupSeconds = 10.f;
+
+	UPROPERTY(Config)
+	float DurationSeconds = 60.f;
+
+	UPROPERTY(Config)
+	float MaxAvgFrameMs = 16.6f;
+
+	UPROPERTY(Config)
+	float MaxP99FrameMs = 33.3f;
+
+	UPROPERTY(Config)
+	float MaxMemoryGrowthMB = 256.f;
+
+	//每个存活敌人的平均占用，口径见 FAuraCombatantMemoryReport
+	UPROPERTY(Config)
+	float MaxEnemyMemoryKB = 1024.f;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UClass>> LoadedEnemyClasses;
+
+	UPROPERTY()
+	TObjectPtr<UClass> LoadedStandInClass;
+
+	TArray<TArray<TWeakObjectPtr<AAuraEnemy>>> SpawnedEnemies;
+	TArray<TWeakObjectPtr<AAuraStandInAIController>> StandIns;
+
+	//通过 UAuraAssetManager 异步预加载的职业资源包，Deinitialize 时释放
+	TArray<ECharacterClass> AcquiredCharacterClasses;
+	int32 NumPendingClassLoads = 0;
+	double PreloadStartTime = 0.0;
+	double ClassPreloadMs = 0.0;
+
+	EPhase Phase = EPhase::Idle;
+	FString OutputPath;
+	FVector ScenarioCenter = FVector::ZeroVector;
+	double PhaseStartTime = 0.0;
+	float TopUpElapsed = 0.f;
+	int32 NumEnemiesSpawned = 0;
+	int32 NumStandInsSpawned = 0;
+
+	//测量阶段内的交战量
+	int32 ProjectilesAtMeasureStart = 0;
+	int32 NumProjectilesDuringMeasure = 0;
+	int32 NumEnemyDeathsDuringMeasure = 0;
+
+	double FrameStartTime = 0.0;
+	TArray<float> FrameMs;
+	uint64 MemoryAtMeasureStart = 0;
+	uint64 PeakMemoryDuringMeasure = 0;
+
+	FDelegateHandle WorldTickStartHandle;
+	FDelegateHandle EndFrameHandle;
+};
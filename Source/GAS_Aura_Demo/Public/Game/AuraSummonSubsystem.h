@@ -0,0 +1,108 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystem/Data/CharacterClassInfo.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraSummonSubsystem.generated.h"
+
+class AAuraEnemy;
+struct FStreamableHandle;
+
+USTRUCT()
+struct FAuraMinionPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AAuraEnemy>> Minions;
+};
+
+/**
+ * 仅服务器：召唤物排队后按每帧预算分帧生成，限制每个召唤者的召唤物数量，
+ * 死亡的 AAuraEnemy 召唤物回收进对象池复用；召唤物类是软引用，召唤者登记后异步预加载（在职业资源包里的引用整个包），
+ * 类还在加载的召唤请求留在队列里，不挡住后面已就绪的请求
+ */
+UCLASS(Config=Game)
+class GAS_AURA_DEMO_API UAuraSummonSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UAuraSummonSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	//召唤者获得召唤技能时调用，召唤者销毁或死亡后释放资源包
+	void RegisterSummoner(AActor* Summoner, TConstArrayView<TSoftClassPtr<APawn>> MinionClasses);
+
+	//超出召唤者上限时返回 false，排队中的也计入上限
+	bool RequestSpawn(AActor* Summoner, const TSoftClassPtr<APawn>& MinionClass, const FTransform& SpawnTransform);
+
+	//存活 + 排队中 的召唤物数量
+	int32 GetNumMinions(const AActor* Summoner) const;
+	int32 GetRemainingMinionSlots(const AActor* Summoner) const;
+
+	//召唤物死亡并播放完溶解后调用，池满则直接销毁
+	void ReleaseMinion(AAuraEnemy* Minion);
+
+private:
+	struct FPendingSpawn
+	{
+		TWeakObjectPtr<AActor> Summoner;
+		TObjectKey<AActor> SummonerKey;
+		TSoftClassPtr<APawn> MinionClass;
+		FTransform SpawnTransform;
+	};
+
+	struct FRegisteredSummoner
+	{
+		TWeakObjectPtr<AActor> Summoner;
+		TArray<FSoftObjectPath> RequestedClasses;
+		TArray<ECharacterClass> AcquiredClasses;
+		TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+	};
+
+	struct FActiveMinion
+	{
+		TWeakObjectPtr<APawn> Minion;
+		TObjectKey<AActor> Summoner;
+	};
+
+	APawn* SpawnMinion(const FPendingSpawn& PendingSpawn, TSubclassOf<APawn> MinionClass);
+	AAuraEnemy* AcquirePooledMinion(TSubclassOf<APawn> MinionClass);
+	void PruneDeadMinions();
+	void PruneSummoners();
+	void ReleaseSummoner(FRegisteredSummoner& Registered);
+
+	//已加载时返回类；未加载时确保有异步加载在进行，bOutLoading 表示仍需等待，加载失败时两者都为空
+	UClass* ResolveMinionClass(const TSoftClassPtr<APawn>& MinionClass, bool& bOutLoading);
+
+	UPROPERTY(Config)
+	int32 MaxMinionsPerSummoner = 8;
+
+	UPROPERTY(Config)
+	int32 MaxSpawnsPerFrame = 2;
+
+	//每帧生成召唤物的时间预算（毫秒），至少生成一个
+	UPROPERTY(Config)
+	float SpawnBudgetMs = 2.f;
+
+	UPROPERTY(Config)
+	int32 MaxPooledMinionsPerClass = 16;
+
+	TArray<FPendingSpawn> PendingSpawns;
+	TArray<FActiveMinion> ActiveMinions;
+	TMap<TObjectKey<AActor>, int32> MinionCounts;
+	TMap<TObjectKey<AActor>, FRegisteredSummoner> RegisteredSummoners;
+
+	//没有经过 RegisterSummoner 的召唤请求在生成时才发起的异步加载
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> MinionClassLoads;
+
+	UPROPERTY()
+	TMap<TSubclassOf<APawn>, FAuraMinionPool> Pools;
+};
@@ -10,6 +10,15 @@
 class UNiagaraSystem;
 class UAnimMontage;
 
+UENUM(BlueprintType)
+enum class EAuraTeam : uint8
+{
+	Neutral,
+	Player,
+	Enemy,
+	MAX UMETA(Hidden)
+};
+
 USTRUCT(BlueprintType)
 struct FTaggedMontage
 {
@@ -46,6 +55,8 @@ class GAS_AURA_DEMO_API ICombatInterface
 public:
 	virtual int32 GetPlayerLevel();
 
+	virtual EAuraTeam GetTeam() const;
+
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	FVector GetCombatSocketLocation(const FGameplayTag& SocketTag);
 
@@ -0,0 +1,32 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IpNetDriver.h"
+#include "AuraNetDriver.generated.h"
+
+/**
+ * 在 IpNetDriver 基础上按连接统计发出的 RPC 次数，供压测报告使用
+ */
+UCLASS(Transient, Config=Engine)
+class GAS_AURA_DEMO_API UAuraNetDriver : public UIpNetDriver
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ProcessRemoteFunction(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms,
+	                                   FFrame* Stack, UObject* SubObject) override;
+
+	//默认关闭，只有压测时才统计
+	void SetRPCCountingEnabled(bool bEnabled) { bCountRPCs = bEnabled; }
+
+	//取出并清零自上次调用以来的计数
+	int32 ConsumeRPCsSent(const UNetConnection* Connection);
+	int32 ConsumeMulticastRPCsSent();
+
+private:
+	bool bCountRPCs = false;
+	int32 MulticastRPCsSent = 0;
+	TMap<TObjectKey<UNetConnection>, int32> RPCsSentByConnection;
+};
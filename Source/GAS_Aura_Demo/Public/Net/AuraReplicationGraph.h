@@ -0,0 +1,89 @@
+// Copyright Liupingan
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "AuraReplicationGraph.generated.h"
+
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_AlwaysRelevant_ForConnection;
+
+enum class EAuraClassRepNodeMapping : uint8
+{
+	PlayerState,            //全局全频率列表（所属连接也从这里收集）：玩家的 ASC 和属性集挂在 PlayerState 上，不能限频
+	RelevantAllConnections, //bAlwaysRelevant
+	OwnerRelevant,          //bOnlyRelevantToOwner，进入所属连接的节点
+	Spatialize_Static,      //不会移动：拾取物/效果物
+	Spatialize_Dynamic,     //每帧移动：角色、投射物
+	Spatialize_Dormancy,    //其他可休眠的 Actor
+};
+
+/**
+ * 敌人/投射物/效果物走空间网格，PlayerState 对所有连接全频率复制，
+ * 只与所属者相关的 Actor 走每个连接自己的节点
+ */
+UCLASS(Transient, Config=Engine)
+class GAS_AURA_DEMO_API UAuraReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	static UAuraReplicationGraph* Get(const UWorld* World);
+
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	//复制图只读取类级别的频率，运行时调整单个 Actor 需要走这里
+	void SetActorNetUpdateFrequency(const AActor* Actor, float NetUpdateFrequency);
+
+private:
+	//按需为 Actor 的类及其尚未处理的父类生成复制设置，类本身是新设置的返回 true
+	bool InitClassReplicationInfo(UClass* ActorClass);
+	EAuraClassRepNodeMapping GetMappingPolicy(const AActor* Actor) const;
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* GetOwnerNodeForConnection(UNetConnection* Connection) const;
+	void RemoveOwnerRelevantActor(const FNewReplicatedActorInfo& ActorInfo);
+	void RoutePendingOwnerRelevantActors();
+
+	UPROPERTY(Config)
+	float GridCellSize = 10000.f;
+
+	UPROPERTY(Config)
+	float SpatialBiasX = -UE_OLD_WORLD_MAX;
+
+	UPROPERTY(Config)
+	float SpatialBiasY = -UE_OLD_WORLD_MAX;
+
+	//只与所属者相关的 Actor 等待连接的最多复制帧数，超时仍没有连接（服务器或 AI 拥有）就不再放入任何节点
+	UPROPERTY(Config)
+	uint32 MaxFramesWithoutNetConnection = 300;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UNetConnection>, TObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection>> OwnerNodes;
+
+	//已生成复制设置的类
+	TSet<TObjectKey<UClass>> InitializedClasses;
+
+	struct FPendingOwnerRelevantActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		uint32 AddedFrame = 0;
+	};
+
+	//尚未拥有连接（例如 PlayerController 刚生成）的 Actor，连接建立后再放入对应节点
+	TArray<FPendingOwnerRelevantActor> ActorsWithoutNetConnection;
+
+	//Actor 放入时所属连接的节点：移除时所属者可能已断开或更换，不能再按当前连接去找
+	TMap<TObjectKey<AActor>, TWeakObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection>> OwnerRelevantActorNodes;
+};
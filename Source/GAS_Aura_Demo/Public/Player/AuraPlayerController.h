@@ -3,13 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AuraAbilityTypes.h"
+#include "GameplayTagContainer.h"
 #include "GameFramework/PlayerController.h"
 #include "AuraPlayerController.generated.h"
 
 class UDamageTextComponent;
 class USplineComponent;
 class UAuraAbilitySystemComponent;
-struct FGameplayTag;
 class IEnemyInterface;
 struct FInputActionValue;
 class UInputAction;
@@ -25,8 +26,11 @@ public:
 	AAuraPlayerController();
 	virtual void PlayerTick(float DeltaTime) override;
 
-	UFUNCTION(Client, Reliable)
-	void ShowDamageNumber(float DamageAmount,ACharacter* TargetCharacter, bool bIsBlockedHit, bool bIsCriticalHit);
+	//仅服务器：同一帧内的伤害数字合并，下一帧打包成一次不可靠RPC下发
+	void QueueDamageNumber(float DamageAmount,ACharacter* TargetCharacter, bool bIsBlockedHit, bool bIsCriticalHit);
+
+	//需要光标命中的地方统一从这里取，压测机器人会替换成脚本指定的命中结果
+	bool GetCursorHitResult(FHitResult& OutHit) const;
 
 protected:
 	virtual void BeginPlay() override;
@@ -81,4 +85,31 @@ private:
 
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UDamageTextComponent> DamageTextComponentClass;
+
+	//伤害数字只是表现，丢包就丢掉
+	UFUNCTION(Client, Unreliable)
+	void ClientShowDamageNumbers(const TArray<FAuraDamageNumber>& DamageNumbers);
+
+	void FlushDamageNumbers();
+	void ShowDamageNumber(const FAuraDamageNumber& DamageNumber);
+
+	TArray<FAuraDamageNumber> PendingDamageNumbers;
+	bool bDamageNumbersFlushPending = false;
+
+	//单个不可靠RPC的条目上限，超出的拆成多次发送
+	static constexpr int32 MaxDamageNumbersPerRPC = 64;
+
+#if !UE_BUILD_SHIPPING
+	//-AuraBot：无界面客户端用脚本模拟 点击移动/对敌人释放技能，输入仍走 AbilityInputTag* 的路径
+	void TickBot(float DeltaTime);
+	void BotStartNextAction();
+	AActor* BotFindTarget() const;
+
+	bool bBotEnabled = false;
+	FHitResult BotCursorHit;
+	FGameplayTag BotHeldInputTag;
+	float BotHoldTimeRemaining = 0.f;
+	float BotIdleTimeRemaining = 0.f;
+	FRandomStream BotRandom;
+#endif
 };
@@ -22,6 +22,9 @@ public:
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 	UAttributeSet* GetAttributeSet() const {return AttributeSet;}
 	FORCEINLINE int32 GetPlayerLevel() const{return Level;}
+
+	//仅服务器上调用
+	void SetPlayerLevel(int32 InLevel);
 	
 protected:
 	UPROPERTY(VisibleAnywhere)
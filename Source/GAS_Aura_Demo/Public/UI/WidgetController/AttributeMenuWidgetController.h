@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "AbilitySystem/Data/AttributeInfo.h"
 #include "UI/WidgetController/AuraWidgetController.h"
 #include "AttributeMenuWidgetController.generated.h"
 
@@ -34,5 +35,11 @@ protected:
 	TObjectPtr<UAttributeInfo> AttributeInfo;
 
 private:
-	void BroadcastAttributeInfo(const FGameplayTag& Tag,const FGameplayAttribute& Attribute) const;
+	void BroadcastAttributeInfo(int32 InfoIndex,const FGameplayAttribute& Attribute);
+
+	//绑定时从 AttributeInfo 复制一份，之后属性变化只改写其中的数值
+	void CacheAttributeInfos();
+
+	UPROPERTY()
+	TArray<FAuraAttributeInfo> CachedAttributeInfos;
 };
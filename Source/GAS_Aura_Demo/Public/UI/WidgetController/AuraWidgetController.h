@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "AttributeSet.h"
 #include "AuraWidgetController.generated.h"
 
 class UAttributeSet;
@@ -55,5 +56,27 @@ protected:
 	
 	UPROPERTY(BlueprintReadOnly,Category="WidgetController")
 	TObjectPtr<UAttributeSet> AttributeSet;
-	
+
+	/** 属性变化时只标记为脏，之后在一帧内（或按 UIUpdateInterval）用最新值统一广播一次 */
+	void BindAttributeChangeCoalesced(const FGameplayAttribute& Attribute, TFunction<void(float)>&& Broadcast);
+
+	//UI刷新间隔（秒），0 表示每帧最多刷新一次
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="WidgetController")
+	float UIUpdateInterval = 0.f;
+
+private:
+	struct FCoalescedAttributeBinding
+	{
+		FGameplayAttribute Attribute;
+		TFunction<void(float)> Broadcast;
+		bool bDirty = false;
+	};
+
+	TArray<FCoalescedAttributeBinding> CoalescedAttributeBindings;
+
+	bool bAttributeFlushPending = false;
+	FTimerHandle AttributeFlushTimerHandle;
+
+	void MarkAttributeBindingDirty(int32 BindingIndex);
+	void FlushDirtyAttributes();
 };
@@ -66,10 +66,16 @@ protected:
 
 	template <typename T>
 	T* GetDataTableRowByTag(UDataTable* DataTable, const FGameplayTag& Tag);
+
+private:
+	//绑定时预先建立 消息标签 -> 数据表行 的索引，行由 MessageWidgetDataTable 持有
+	void BuildMessageWidgetRowIndex();
+
+	TMap<FGameplayTag, const FUIWidgetRow*> MessageWidgetRowsByTag;
 };
 
 template <typename T>
 T* UOverlayWidgetController::GetDataTableRowByTag(UDataTable* DataTable, const FGameplayTag& Tag)
 {
-	return DataTable->FindRow<T>(Tag.GetTagName(),TEXT(""));
+	return DataTable ? DataTable->FindRow<T>(Tag.GetTagName(),TEXT("")) : nullptr;
 }
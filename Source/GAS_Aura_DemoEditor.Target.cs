@@ -9,6 +9,7 @@ public class GAS_Aura_DemoEditorTarget : TargetRules
 	{
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
+		bWithPushModel = true;
 
 		ExtraModuleNames.AddRange( new string[] { "GAS_Aura_Demo" } );
 	}
@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+# 本机启动 1 个专用服务器 + N 个 -nullrhi 机器人客户端（全部走 localhost），
+# 服务器把帧时间/每个连接的带宽/RPC 次数写进 CSV，到时长后服务器自动退出并关闭所有客户端。
+#
+# 用法: UE_EDITOR=/path/to/Engine/Binaries/Linux/UnrealEditor ./run_local_load_test.sh [客户端数=16] [秒数=300]
+# 可选环境变量: MAP (默认 /Game/Maps/StartupMap)  PORT (默认 7777)  OUT_DIR
+
+set -euo pipefail
+
+NUM_CLIENTS="${1:-16}"
+DURATION="${2:-300}"
+MAP="${MAP:-/Game/Maps/StartupMap}"
+PORT="${PORT:-7777}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+PROJECT="$PROJECT_DIR/GAS_Aura_Demo.uproject"
+EDITOR="${UE_EDITOR:?set UE_EDITOR to the UnrealEditor binary}"
+OUT_DIR="${OUT_DIR:-$PROJECT_DIR/Saved/LoadTest/$(date +%Y%m%d-%H%M%S)}"
+mkdir -p "$OUT_DIR"
+
+CLIENT_PIDS=()
+cleanup() {
+	for pid in "${CLIENT_PIDS[@]}"; do
+		kill "$pid" 2>/dev/null || true
+	done
+	wait 2>/dev/null || true
+}
+trap cleanup EXIT INT TERM
+
+echo "Server: $MAP on port $PORT for ${DURATION}s, output in $OUT_DIR"
+"$EDITOR" "$PROJECT" "$MAP" -server -port="$PORT" -unattended -nosteam -log \
+	-abslog="$OUT_DIR/server.log" \
+	-AuraLoadTestCSV="$OUT_DIR/server.csv" -AuraLoadTestDuration="$DURATION" &
+SERVER_PID=$!
+
+# 等服务器完成加载再连客户端
+sleep "${SERVER_WARMUP:-20}"
+
+for ((i = 0; i < NUM_CLIENTS; i++)); do
+	"$EDITOR" "$PROJECT" "127.0.0.1:$PORT" -game -nullrhi -nosound -unattended -nosteam -AuraBot \
+		-abslog="$OUT_DIR/client_$i.log" >/dev/null 2>&1 &
+	CLIENT_PIDS+=($!)
+	sleep 1
+done
+
+echo "Started $NUM_CLIENTS bot clients, waiting for server to finish"
+wait "$SERVER_PID" || true
+echo "Report: $OUT_DIR/server.csv"
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+# 读取 CSV 分析器的输出（csvprofile start/stop 或 -csvCaptureFrames），按预算检查每帧耗时。
+# AuraAI/AuraProjectiles/AuraGAS/AuraUI/AuraInput/AuraNet 分类取该分类下所有独占计时列
+# （Exclusive/<线程>/<分类>/<Stat>）之和：独占时间不含嵌套的内层作用域，各分类之间不会重复计入。
+#
+# 用法: csv_budget_report.py <capture.csv> [--budgets combat_budgets.json] [--baseline other.csv] [--worst 10]
+# 超预算帧比例大于 max_over_budget_fraction 时返回 1，便于夜间构建直接判失败。
+
+import argparse
+import csv
+import json
+import os
+import sys
+
+DEFAULT_BUDGETS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "combat_budgets.json")
+
+
+def load_capture(path):
+    """返回 (列名, 每帧的 {列名: 数值})，忽略文件末尾的元数据行。"""
+    with open(path, newline="", encoding="utf-8-sig") as f:
+        rows = list(csv.reader(f))
+    if not rows:
+        raise ValueError(f"{path}: empty capture")
+
+    header = [name.strip() for name in rows[0]]
+    frames = []
+    for row in rows[1:]:
+        if not row or row[0].startswith("["):
+            break
+        if row[0].strip() == header[0]:  # 文件末尾重复的表头
+            break
+        frame = {}
+        for name, value in zip(header, row):
+            try:
+                frame[name] = float(value)
+            except ValueError:
+                pass
+        frames.append(frame)
+    return header, frames
+
+
+def frame_metrics(header, frames, budgets):
+    """每帧计算需要检查的指标：直接列 + 分类合计。"""
+    categories = budgets.get("category_budget_ms", {})
+    category_columns = {
+        category: [name for name in header if name.startswith("Exclusive/") and f"/{category}/" in name]
+        for category in categories
+    }
+
+    metrics = []
+    for frame in frames:
+        values = {name: frame.get(name, 0.0) for name in budgets.get("frame_budget_ms", {})}
+        for category, columns in category_columns.items():
+            values[category] = sum(frame.get(name, 0.0) for name in columns)
+        for name, value in frame.items():
+            if name.startswith("AuraCombat/"):
+                values[name] = value
+        metrics.append(values)
+    return metrics
+
+
+def percentile(values, pct):
+    if not values:
+        return 0.0
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, max(0, int(round(pct / 100.0 * (len(ordered) - 1)))))
+    return ordered[index]
+
+
+def summarize(metrics):
+    names = sorted({name for frame in metrics for name in frame})
+    summary = {}
+    for name in names:
+        values = [frame.get(name, 0.0) for frame in metrics]
+        summary[name] = {
+            "avg": sum(values) / len(values) if values else 0.0,
+            "p50": percentile(values, 50),
+            "p95": percentile(values, 95),
+            "p99": percentile(values, 99),
+            "max": max(values) if values else 0.0,
+        }
+    return summary
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flag combat frames over budget in a CSV profiler capture.")
+    parser.add_argument("capture")
+    parser.add_argument("--budgets", default=DEFAULT_BUDGETS)
+    parser.add_argument("--baseline", help="capture from another build of the same scripted encounter")
+    parser.add_argument("--worst", type=int, default=10, help="number of worst over-budget frames to list")
+    args = parser.parse_args()
+
+    with open(args.budgets, encoding="utf-8") as f:
+        budgets = json.load(f)
+    limits = dict(budgets.get("frame_budget_ms", {}))
+    limits.update(budgets.get("category_budget_ms", {}))
+
+    header, frames = load_capture(args.capture)
+    metrics = frame_metrics(header, frames, budgets)
+    summary = summarize(metrics)
+
+    over_budget = []
+    for index, frame in enumerate(metrics):
+        exceeded = {name: frame[name] for name, limit in limits.items() if frame.get(name, 0.0) > limit}
+        if exceeded:
+            over_budget.append((index, exceeded))
+
+    print(f"{args.capture}: {len(metrics)} frames")
+    print(f"{'metric':<32}{'budget':>9}{'avg':>9}{'p50':>9}{'p95':>9}{'p99':>9}{'max':>9}")
+    for name, stats in summary.items():
+        budget = f"{limits[name]:.2f}" if name in limits else "-"
+        print(f"{name:<32}{budget:>9}" + "".join(f"{stats[key]:>9.2f}" for key in ("avg", "p50", "p95", "p99", "max")))
+
+    if args.baseline:
+        base_header, base_frames = load_capture(args.baseline)
+        base_summary = summarize(frame_metrics(base_header, base_frames, budgets))
+        print(f"\nvs baseline {args.baseline} ({len(base_frames)} frames), avg / p99 delta:")
+        for name, stats in summary.items():
+            if name in base_summary:
+                base = base_summary[name]
+                print(f"{name:<32}{stats['avg'] - base['avg']:>+9.2f}{stats['p99'] - base['p99']:>+9.2f}")
+
+    fraction = len(over_budget) / len(metrics) if metrics else 0.0
+    print(f"\nover budget: {len(over_budget)} frames ({fraction:.2%})")
+    worst = sorted(over_budget, key=lambda item: max(v - limits[k] for k, v in item[1].items()), reverse=True)
+    for index, exceeded in worst[:args.worst]:
+        details = ", ".join(f"{name} {value:.2f}/{limits[name]:.2f}" for name, value in sorted(exceeded.items()))
+        print(f"  frame {index}: {details}")
+
+    allowed = budgets.get("max_over_budget_fraction", 0.0)
+    if fraction > allowed:
+        print(f"FAIL: over-budget fraction {fraction:.2%} exceeds {allowed:.2%}")
+        return 1
+    print("PASS")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,45 @@
+#!/usr/bin/env bash
+# 无头压力测试：-server -nullrhi 启动服务器，AuraStressTestSubsystem 生成敌人和 AI 替身交战，
+# 预热后统计服务器帧耗时(平均/P99)与内存增长，写出 JSON 并退出；超出预算时本脚本返回非 0，可直接接入 CI。
+#
+# 用法: UE_EDITOR=/path/to/Engine/Binaries/Linux/UnrealEditor ./run_stress_test.sh [秒数=60] [额外参数...]
+# 额外参数例: -AuraStressEnemiesRanger=30 -AuraStressStandIns=8 -AuraStressMaxP99FrameMs=25
+# 加 -llm -llmcsv 可按 Aura/* LLM 标签记录内存（会影响帧时间，不要和帧预算一起判定）
+# 可选环境变量: MAP (默认 /Game/Maps/StartupMap)  OUT_DIR
+
+set -euo pipefail
+
+DURATION="${1:-60}"
+shift || true
+MAP="${MAP:-/Game/Maps/StartupMap}"
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+PROJECT="$PROJECT_DIR/GAS_Aura_Demo.uproject"
+EDITOR="${UE_EDITOR:?set UE_EDITOR to the UnrealEditor binary}"
+OUT_DIR="${OUT_DIR:-$PROJECT_DIR/Saved/StressTest/$(date +%Y%m%d-%H%M%S)}"
+RESULT="$OUT_DIR/result.json"
+mkdir -p "$OUT_DIR"
+
+echo "Stress test: $MAP for ${DURATION}s, output in $OUT_DIR"
+"$EDITOR" "$PROJECT" "$MAP" -server -nullrhi -nosound -unattended -nosteam -log \
+	-abslog="$OUT_DIR/server.log" \
+	-AuraStressTest -AuraStressDuration="$DURATION" -AuraStressOutput="$RESULT" "$@" || true
+
+# 以 JSON 为准判定结果，进程退出码在崩溃/超时时不可靠
+if [[ ! -f "$RESULT" ]]; then
+	echo "FAILED: no result written, see $OUT_DIR/server.log"
+	exit 2
+fi
+
+python3 - "$RESULT" <<'PY'
+import json, sys
+result = json.load(open(sys.argv[1]))
+frame, memory = result["ServerFrame"], result["Memory"]
+print(f"avg {frame['AvgMs']:.3f} ms | p99 {frame['P99Ms']:.3f} ms | max {frame['MaxMs']:.3f} ms | "
+      f"{frame['Frames']} frames | memory +{memory['GrowthMB']:.1f} MB, {memory['PerEnemyKB']:.1f} KB per enemy")
+for failure in result["Failures"]:
+    print(f"  FAIL: {failure}")
+print("PASSED" if result["Passed"] else "FAILED")
+sys.exit(0 if result["Passed"] else 1)
+PY